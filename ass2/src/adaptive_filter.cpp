@@ -0,0 +1,110 @@
+#include "./adaptive_filter.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace fsv {
+    namespace {
+        // below this many nanoseconds per call, batch timings are mostly noise
+        constexpr double min_cost = 0.1;
+
+        // Filters that cannot reject score zero; otherwise higher is better. The floor on cost keeps
+        // filters too cheap to time comparable by their rejection rate alone.
+        auto score(const adaptive_filter::filter_stats& s) -> double {
+            return s.rejection_rate() / std::max(s.cost(), min_cost);
+        }
+    } // namespace
+
+    auto adaptive_filter::filter_stats::rejection_rate() const noexcept -> double {
+        return calls == 0 ? 0.0 : static_cast<double>(rejects) / static_cast<double>(calls);
+    }
+
+    auto adaptive_filter::filter_stats::cost() const noexcept -> double {
+        return timed_calls == 0 ? 0.0 : static_cast<double>(time.count()) / static_cast<double>(timed_calls);
+    }
+
+    adaptive_filter::adaptive_filter(std::vector<filter> filts, std::size_t sample_size)
+    : state_{std::make_shared<state>()} {
+        state_->stats.resize(filts.size());
+        state_->order.resize(filts.size());
+        std::iota(state_->order.begin(), state_->order.end(), std::size_t{0});
+        state_->filts = std::move(filts);
+        state_->remaining = sample_size;
+    }
+
+    auto adaptive_filter::operator()(const char& c) const -> bool {
+        if (state_->remaining != 0) {
+            return sample(c);
+        }
+        for (auto i : state_->order) {
+            if (!state_->filts[i](c)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    auto adaptive_filter::sample(const char& c) const -> bool {
+        auto& st = *state_;
+        auto result = true;
+        const auto timed = st.sampled++ % timing_interval == 0;
+        for (std::size_t i = 0; i < st.filts.size(); ++i) {
+            const auto& f = st.filts[i];
+            auto& stats = st.stats[i];
+            ++stats.calls;
+            if (!f(c)) {
+                ++stats.rejects;
+                result = false;
+            }
+            if (timed) {
+                // results go to a volatile so the calls cannot be optimised away
+                volatile auto sink = true;
+                const auto start = std::chrono::steady_clock::now();
+                for (std::size_t k = 0; k < timing_batch; ++k) {
+                    sink = f(c);
+                }
+                stats.time += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()
+                                                                                   - start);
+                stats.timed_calls += timing_batch;
+                static_cast<void>(sink);
+            }
+        }
+        if (--st.remaining == 0) {
+            std::stable_sort(st.order.begin(), st.order.end(), [&st](std::size_t lhs, std::size_t rhs) {
+                return score(st.stats[lhs]) > score(st.stats[rhs]);
+            });
+        }
+        return result;
+    }
+
+    auto adaptive_filter::stats() const -> std::vector<filter_stats> {
+        return state_->stats;
+    }
+
+    auto adaptive_filter::order() const -> std::vector<std::size_t> {
+        return state_->order;
+    }
+
+    auto adaptive_filter::sampling() const noexcept -> bool {
+        return state_->remaining != 0;
+    }
+
+    auto adaptive_filter::pin(const std::vector<std::size_t>& order) -> void {
+        auto seen = std::vector<bool>(state_->filts.size(), false);
+        if (order.size() != seen.size()) {
+            throw std::invalid_argument{"adaptive_filter::pin: expected " + std::to_string(seen.size())
+                                        + " indices, got " + std::to_string(order.size())};
+        }
+        for (auto i : order) {
+            if (i >= seen.size() || seen[i]) {
+                throw std::invalid_argument{"adaptive_filter::pin: " + std::to_string(i)
+                                            + " is out of range or repeated"};
+            }
+            seen[i] = true;
+        }
+        state_->order = order;
+        state_->remaining = 0;
+    }
+} // namespace fsv
@@ -0,0 +1,69 @@
+#ifndef COMP6771_ASS2_ADAPTIVE_FILTER_H
+#define COMP6771_ASS2_ADAPTIVE_FILTER_H
+
+#include "./filtered_string_view.h"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace fsv {
+    // A conjunction of type-erased filters that learns a good evaluation order. For the first
+    // `sample_size` characters every filter is evaluated. Once every `timing_interval` of those
+    // characters, each filter is also timed over `timing_batch` calls on it, since a clock read
+    // costs more than a typical predicate call. Afterwards the filters are reordered by rejections
+    // per unit of cost, so that selective, cheap filters short-circuit the rest. Pass it to
+    // compose() like any other predicate. The filters should be pure: timing calls them repeatedly.
+    //
+    // Copies share their statistics, so a view and the filter it was built from report the same
+    // state. Not thread-safe: operator() updates that shared state, so one adaptive_filter must not
+    // be evaluated concurrently. In particular, do not give it to chunked_view, which runs its
+    // predicate on several threads at once.
+    class adaptive_filter {
+    public:
+        struct filter_stats {
+            std::size_t calls = 0;
+            std::size_t rejects = 0;
+            // calls made only to be timed, on top of `calls`; `time` is their total
+            std::size_t timed_calls = 0;
+            std::chrono::nanoseconds time{0};
+
+            auto rejection_rate() const noexcept -> double;
+            auto cost() const noexcept -> double; // nanoseconds per call
+        };
+
+        static constexpr std::size_t default_sample_size = 1024;
+        static constexpr std::size_t timing_interval = 16;
+        static constexpr std::size_t timing_batch = 16;
+
+        explicit adaptive_filter(std::vector<filter> filts, std::size_t sample_size = default_sample_size);
+
+        auto operator()(const char& c) const -> bool;
+
+        // stats()[i] describes filts[i] as originally given
+        auto stats() const -> std::vector<filter_stats>;
+        // indices into the original filts, in the order they are evaluated
+        auto order() const -> std::vector<std::size_t>;
+        auto sampling() const noexcept -> bool;
+
+        // Fixes the evaluation order and stops sampling. Throws std::invalid_argument if `order`
+        // is not a permutation of the filter indices.
+        auto pin(const std::vector<std::size_t>& order) -> void;
+
+    private:
+        struct state {
+            std::vector<filter> filts;
+            std::vector<filter_stats> stats;
+            std::vector<std::size_t> order;
+            std::size_t remaining;
+            std::size_t sampled = 0;
+        };
+
+        auto sample(const char& c) const -> bool;
+
+        std::shared_ptr<state> state_;
+    };
+} // namespace fsv
+
+#endif // COMP6771_ASS2_ADAPTIVE_FILTER_H
@@ -0,0 +1,74 @@
+#include "./adaptive_filter.h"
+#include <catch2/catch.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    auto const not_space = [](const char& c) { return c != ' '; };
+    auto const is_x = [](const char& c) { return c == 'x'; };
+    auto const not_y = [](const char& c) { return c != 'y'; };
+} // namespace
+
+TEST_CASE("adaptive_filter matches the plain composition") {
+    const auto text = std::string{"x xy yx xxx abc x y z"};
+    const auto filts = std::vector<fsv::filter>{not_space, not_y, is_x};
+    auto source = fsv::filtered_string_view{text};
+
+    auto adaptive = fsv::adaptive_filter{filts, 4};
+    auto view = fsv::compose(source, adaptive);
+    REQUIRE(view == fsv::compose(source, filts));
+    REQUIRE(static_cast<std::string>(view) == "xxxxxxx");
+}
+
+TEST_CASE("adaptive_filter sampling and reordering") {
+    const auto text = std::string(100, 'a') + "x";
+    auto adaptive = fsv::adaptive_filter{{not_space, not_y, is_x}, 64};
+    REQUIRE(adaptive.sampling());
+    REQUIRE(adaptive.order() == std::vector<std::size_t>{0, 1, 2});
+
+    // copies, including the one held by the view, share their statistics
+    auto view = fsv::compose(fsv::filtered_string_view{text}, adaptive);
+    REQUIRE(view.size() == 1);
+    REQUIRE_FALSE(adaptive.sampling());
+
+    const auto stats = adaptive.stats();
+    REQUIRE(stats.size() == 3);
+    for (const auto& s : stats) {
+        REQUIRE(s.calls == 64);
+        // one batch for every timing_interval sampled characters
+        REQUIRE(s.timed_calls == 64 / fsv::adaptive_filter::timing_interval * fsv::adaptive_filter::timing_batch);
+        REQUIRE(s.cost() >= 0.0);
+    }
+    REQUIRE(stats[0].rejects == 0);
+    REQUIRE(stats[1].rejects == 0);
+    REQUIRE(stats[2].rejects == 64);
+    REQUIRE(stats[2].rejection_rate() == 1.0);
+    REQUIRE(adaptive.order().front() == 2);
+
+    SECTION("calls after sampling are not recorded") {
+        REQUIRE(view.size() == 1);
+        REQUIRE(adaptive.stats()[2].calls == 64);
+    }
+}
+
+TEST_CASE("adaptive_filter pinning") {
+    auto adaptive = fsv::adaptive_filter{{not_space, not_y, is_x}};
+    adaptive.pin({2, 0, 1});
+    REQUIRE_FALSE(adaptive.sampling());
+    REQUIRE(adaptive.order() == std::vector<std::size_t>{2, 0, 1});
+    REQUIRE(adaptive('x'));
+    REQUIRE_FALSE(adaptive(' '));
+    REQUIRE(adaptive.stats()[0].calls == 0);
+
+    REQUIRE_THROWS_AS(adaptive.pin({0, 1}), std::invalid_argument);
+    REQUIRE_THROWS_AS(adaptive.pin({0, 1, 1}), std::invalid_argument);
+    REQUIRE_THROWS_AS(adaptive.pin({0, 1, 3}), std::invalid_argument);
+    REQUIRE(adaptive.order() == std::vector<std::size_t>{2, 0, 1});
+}
+
+TEST_CASE("adaptive_filter with no filters accepts everything") {
+    auto adaptive = fsv::adaptive_filter{{}, 2};
+    REQUIRE(fsv::compose(fsv::filtered_string_view{"abc"}, adaptive).size() == 3);
+    REQUIRE(adaptive.order().empty());
+}
@@ -0,0 +1,104 @@
+#include "./aggregates.h"
+
+#include <bit>
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace fsv {
+    namespace {
+        constexpr std::size_t block_size = 64;
+
+        // calls visit(first, last) on each run of passing characters until it returns false
+        template<typename F>
+        auto visit_runs(const filtered_string_view& fsv, F&& visit) -> void {
+            for (auto [first, last] = fsv.next_run(fsv.data()); first != last;
+                 std::tie(first, last) = fsv.next_run(last)) {
+                if (!visit(first, last)) {
+                    return;
+                }
+            }
+        }
+    } // namespace
+
+    auto count(const filtered_string_view& fsv, char c) -> std::size_t {
+        std::size_t n = 0;
+        visit_runs(fsv, [&n, c](const char* first, const char* last) {
+#ifdef __SSE2__
+            const auto needle = _mm_set1_epi8(c);
+            for (; last - first >= 16; first += 16) {
+                const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)));
+                n += static_cast<std::size_t>(std::popcount(mask));
+            }
+#endif
+            n += static_cast<std::size_t>(std::count(first, last, c));
+            return true;
+        });
+        return n;
+    }
+
+    auto count_if(const filtered_string_view& fsv, const char_class& cls) -> std::size_t {
+        std::size_t n = 0;
+        visit_runs(fsv, [&n, &cls](const char* first, const char* last) {
+            while (first != last) {
+                const auto len = std::min(block_size, static_cast<std::size_t>(last - first));
+                n += static_cast<std::size_t>(std::popcount(cls.match_mask(first, len)));
+                first += len;
+            }
+            return true;
+        });
+        return n;
+    }
+
+    auto histogram(const filtered_string_view& fsv) -> std::array<std::size_t, 256> {
+        // four interleaved tables, so that runs of equal characters do not serialise on one counter
+        std::array<std::array<std::size_t, 256>, 4> partial{};
+        visit_runs(fsv, [&partial](const char* first, const char* last) {
+            for (; last - first >= 4; first += 4) {
+                ++partial[0][static_cast<unsigned char>(first[0])];
+                ++partial[1][static_cast<unsigned char>(first[1])];
+                ++partial[2][static_cast<unsigned char>(first[2])];
+                ++partial[3][static_cast<unsigned char>(first[3])];
+            }
+            for (; first != last; ++first) {
+                ++partial[0][static_cast<unsigned char>(*first)];
+            }
+            return true;
+        });
+        auto result = std::array<std::size_t, 256>{};
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = partial[0][i] + partial[1][i] + partial[2][i] + partial[3][i];
+        }
+        return result;
+    }
+
+    auto find_first_of(const filtered_string_view& fsv, const char_class& cls) -> std::size_t {
+        std::size_t index = 0;
+        auto found = filtered_string_view::npos;
+        visit_runs(fsv, [&](const char* first, const char* last) {
+            while (first != last) {
+                const auto len = std::min(block_size, static_cast<std::size_t>(last - first));
+                const auto mask = cls.match_mask(first, len);
+                if (mask != 0) {
+                    found = index + static_cast<std::size_t>(std::countr_zero(mask));
+                    return false;
+                }
+                index += len;
+                first += len;
+            }
+            return true;
+        });
+        return found;
+    }
+
+    auto any_of(const filtered_string_view& fsv, const char_class& cls) -> bool {
+        return find_first_of(fsv, cls) != filtered_string_view::npos;
+    }
+
+    auto all_of(const filtered_string_view& fsv, const char_class& cls) -> bool {
+        return !any_of(fsv, !cls);
+    }
+} // namespace fsv
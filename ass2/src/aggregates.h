@@ -0,0 +1,57 @@
+#ifndef COMP6771_ASS2_AGGREGATES_H
+#define COMP6771_ASS2_AGGREGATES_H
+
+#include "./filtered_string_view.h"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+
+// Bulk queries over the filtered text of a view. Each walks the view's runs of passing characters
+// (see filtered_string_view::next_run) instead of testing characters one at a time, and works on
+// 16 or 64 characters at a time within a run where it can. Positions are filtered indices.
+namespace fsv {
+    // number of occurrences of `c`
+    [[nodiscard]] auto count(const filtered_string_view& fsv, char c) -> std::size_t;
+    [[nodiscard]] auto count_if(const filtered_string_view& fsv, const char_class& cls) -> std::size_t;
+    // number of characters of each value, indexed by the character as unsigned char
+    [[nodiscard]] auto histogram(const filtered_string_view& fsv) -> std::array<std::size_t, 256>;
+    // index of the first character in `cls`, or filtered_string_view::npos
+    [[nodiscard]] auto find_first_of(const filtered_string_view& fsv, const char_class& cls) -> std::size_t;
+    [[nodiscard]] auto any_of(const filtered_string_view& fsv, const char_class& cls) -> bool;
+    // true for an empty view
+    [[nodiscard]] auto all_of(const filtered_string_view& fsv, const char_class& cls) -> bool;
+
+    // Overloads for arbitrary predicates, still run by run but calling `pred` on each character.
+    // A run is empty only at the end of the view, which ends these loops.
+    template<typename Pred>
+        requires std::predicate<const Pred&, const char&>
+    [[nodiscard]] auto count_if(const filtered_string_view& fsv, const Pred& pred) -> std::size_t {
+        std::size_t n = 0;
+        for (auto [first, last] = fsv.next_run(fsv.data()); first != last; std::tie(first, last) = fsv.next_run(last)) {
+            n += static_cast<std::size_t>(std::count_if(first, last, pred));
+        }
+        return n;
+    }
+
+    template<typename Pred>
+        requires std::predicate<const Pred&, const char&>
+    [[nodiscard]] auto any_of(const filtered_string_view& fsv, const Pred& pred) -> bool {
+        for (auto [first, last] = fsv.next_run(fsv.data()); first != last; std::tie(first, last) = fsv.next_run(last)) {
+            if (std::any_of(first, last, pred)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<typename Pred>
+        requires std::predicate<const Pred&, const char&>
+    [[nodiscard]] auto all_of(const filtered_string_view& fsv, const Pred& pred) -> bool {
+        return !any_of(fsv, [&pred](const char& c) { return !pred(c); });
+    }
+} // namespace fsv
+
+#endif // COMP6771_ASS2_AGGREGATES_H
@@ -0,0 +1,66 @@
+#include "./aggregates.h"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+    auto const no_spaces = [](const char& c) { return c != ' '; };
+    auto const is_digit = [](const char& c) { return c >= '0' && c <= '9'; };
+
+    auto sample_text() -> std::string {
+        auto text = std::string{};
+        for (auto i = 0; i < 300; ++i) {
+            text += "row " + std::to_string(i * 7) + ": value=" + std::to_string(i % 13) + "; \xE9\n";
+        }
+        return text;
+    }
+} // namespace
+
+TEST_CASE("aggregates agree with the filtered string") {
+    const auto text = sample_text();
+    const auto digits = fsv::char_class{"0123456789"};
+    const auto views = std::vector<fsv::filtered_string_view>{
+        fsv::filtered_string_view{text},
+        fsv::filtered_string_view{text, no_spaces},
+        fsv::filtered_string_view{text, fsv::char_class{"aeiou0123456789\xE9"}},
+        fsv::filtered_string_view{text, [](const char& c) { return c != '='; }},
+    };
+    for (const auto& view : views) {
+        const auto str = static_cast<std::string>(view);
+
+        REQUIRE(fsv::count(view, '0') == static_cast<std::size_t>(std::count(str.begin(), str.end(), '0')));
+        REQUIRE(fsv::count(view, '\xE9') == static_cast<std::size_t>(std::count(str.begin(), str.end(), '\xE9')));
+        const auto expected_digits = static_cast<std::size_t>(std::count_if(str.begin(), str.end(), is_digit));
+        REQUIRE(fsv::count_if(view, digits) == expected_digits);
+        REQUIRE(fsv::count_if(view, is_digit) == expected_digits);
+
+        const auto hist = fsv::histogram(view);
+        for (auto c = 0; c < 256; ++c) {
+            const auto expected = std::count(str.begin(), str.end(), static_cast<char>(c));
+            REQUIRE(hist[static_cast<std::size_t>(c)] == static_cast<std::size_t>(expected));
+        }
+
+        const auto first_digit = str.find_first_of("0123456789");
+        REQUIRE(fsv::find_first_of(view, digits)
+                == (first_digit == std::string::npos ? fsv::filtered_string_view::npos : first_digit));
+        REQUIRE(fsv::any_of(view, digits) == (first_digit != std::string::npos));
+        REQUIRE(fsv::any_of(view, is_digit) == (first_digit != std::string::npos));
+    }
+}
+
+TEST_CASE("all_of and any_of") {
+    auto digits_only = fsv::filtered_string_view{"a1b22c333", is_digit};
+    REQUIRE(fsv::all_of(digits_only, fsv::char_class{"123"}));
+    REQUIRE_FALSE(fsv::all_of(digits_only, fsv::char_class{"12"}));
+    REQUIRE(fsv::all_of(digits_only, is_digit));
+    REQUIRE_FALSE(fsv::any_of(digits_only, fsv::char_class{"abc"}));
+    REQUIRE(fsv::find_first_of(digits_only, fsv::char_class{"3"}) == 3);
+
+    auto empty = fsv::filtered_string_view{};
+    REQUIRE(fsv::all_of(empty, fsv::char_class{}));
+    REQUIRE_FALSE(fsv::any_of(empty, fsv::char_class{"a"}));
+    REQUIRE(fsv::count(empty, 'a') == 0);
+    REQUIRE(fsv::histogram(empty) == std::array<std::size_t, 256>{});
+    REQUIRE(fsv::find_first_of(empty, fsv::char_class{"a"}) == fsv::filtered_string_view::npos);
+}
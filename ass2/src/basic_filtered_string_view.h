@@ -0,0 +1,300 @@
+#ifndef COMP6771_ASS2_BASIC_FSV_H
+#define COMP6771_ASS2_BASIC_FSV_H
+
+#include "./filtered_string_view.h"
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace fsv {
+    template<typename Pred>
+    concept char_predicate = std::copy_constructible<Pred> && std::predicate<const Pred&, const char&>;
+
+    // the "true" predicate as a literal type
+    struct always_true {
+        constexpr auto operator()(const char&) const noexcept -> bool {
+            return true;
+        }
+    };
+
+    // the conjunction of several predicates, evaluated left to right with short-circuiting
+    template<char_predicate... Filts>
+    struct conjunction {
+        std::tuple<Filts...> filts;
+
+        constexpr auto operator()(const char& c) const -> bool {
+            return std::apply([&c](const auto&... f) { return (f(c) && ...); }, filts);
+        }
+    };
+
+    // A non-owning reference to a predicate: two pointers, trivially copyable, never allocates.
+    // The referenced callable must outlive every view using it, so binding a temporary is an error.
+    class filter_ref {
+    public:
+        template<typename F>
+            requires(!std::same_as<std::remove_cvref_t<F>, filter_ref>) && std::predicate<const F&, const char&>
+        filter_ref(const F& f) noexcept
+        : obj_(std::addressof(f))
+        , call_([](const void* obj, const char& c) -> bool { return std::invoke(*static_cast<const F*>(obj), c); }) {}
+        template<typename F>
+            requires(!std::same_as<std::remove_cvref_t<F>, filter_ref>)
+        filter_ref(const F&&) = delete;
+
+        auto operator()(const char& c) const -> bool {
+            return call_(obj_, c);
+        }
+
+    private:
+        const void* obj_;
+        auto (*call_)(const void*, const char&) -> bool;
+    };
+
+    template<char_predicate Pred = always_true>
+    class basic_filtered_string_view;
+
+    // Like compose(), the predicate of `fsv` is replaced by the conjunction of `filts`.
+    template<typename Pred, char_predicate... Filts>
+    constexpr auto compose(const basic_filtered_string_view<Pred>& fsv, Filts... filts)
+        -> basic_filtered_string_view<conjunction<Filts...>>;
+
+    // Like substr(), but the result keeps the predicate's type, so instead of narrowing the predicate
+    // it narrows the underlying range: data() points at the first character of the slice.
+    template<typename Pred>
+    constexpr auto substr(const basic_filtered_string_view<Pred>& fsv,
+                          std::size_t pos = 0,
+                          std::optional<std::size_t> count = std::nullopt) -> basic_filtered_string_view<Pred>;
+
+    // A filtered_string_view whose predicate is held by its own type instead of a std::function.
+    // Everything is constexpr, so with a constexpr-callable predicate (a captureless lambda,
+    // char_class, ...) views can be built, indexed, compared and sliced at compile time.
+    template<char_predicate Pred>
+    class basic_filtered_string_view {
+        class iter {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = char;
+            using reference = const char&;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+
+            constexpr iter() = default;
+
+            constexpr auto operator*() const -> reference {
+                return *cur_;
+            }
+
+            constexpr auto operator++() -> iter& {
+                do {
+                    ++cur_;
+                } while (cur_ != last_ && !(*pred_)(*cur_));
+                return *this;
+            }
+            constexpr auto operator++(int) -> iter {
+                auto old = *this;
+                ++*this;
+                return old;
+            }
+            constexpr auto operator--() -> iter& {
+                do {
+                    --cur_;
+                } while (!(*pred_)(*cur_));
+                return *this;
+            }
+            constexpr auto operator--(int) -> iter {
+                auto old = *this;
+                --*this;
+                return old;
+            }
+
+            friend constexpr auto operator==(const iter& lhs, const iter& rhs) -> bool {
+                return lhs.cur_ == rhs.cur_;
+            }
+
+        private:
+            constexpr iter(const char* cur, const char* last, const Pred* pred)
+            : cur_(cur)
+            , last_(last)
+            , pred_(pred) {}
+
+            const char* cur_ = nullptr;
+            const char* last_ = nullptr;
+            const Pred* pred_ = nullptr;
+
+            friend class basic_filtered_string_view;
+        };
+
+    public:
+        using iterator = iter;
+        using const_iterator = iter;
+        using reverse_iterator = std::reverse_iterator<iter>;
+        using const_reverse_iterator = std::reverse_iterator<iter>;
+
+        constexpr basic_filtered_string_view() noexcept(std::is_nothrow_default_constructible_v<Pred>)
+            requires std::default_initializable<Pred>
+        = default;
+        constexpr basic_filtered_string_view(const char* str)
+            requires std::default_initializable<Pred>
+        : basic_filtered_string_view(str, Pred{}) {}
+        constexpr basic_filtered_string_view(const char* str, Pred predicate)
+        : basic_filtered_string_view(str, std::char_traits<char>::length(str), std::move(predicate)) {}
+        constexpr basic_filtered_string_view(const char* str, std::size_t len, Pred predicate)
+        : ptr_(str)
+        , length_(len)
+        , pred_(std::move(predicate)) {}
+
+        constexpr auto operator[](std::size_t n) const -> const char& {
+            auto it = begin();
+            for (; n != 0; --n) {
+                ++it;
+            }
+            return *it;
+        }
+        constexpr auto at(std::size_t index) const -> const char& {
+            if (index >= size()) {
+                throw std::domain_error{"filtered_string_view::at(" + std::to_string(index) + "): invalid index"};
+            }
+            return (*this)[index];
+        }
+        constexpr explicit operator std::string() const {
+            return std::string(begin(), end());
+        }
+        // a runtime filtered_string_view over the same data, with the predicate type-erased
+        explicit operator filtered_string_view() const {
+            return filtered_string_view{ptr_, length_, pred_};
+        }
+
+        [[nodiscard]] constexpr auto size() const -> std::size_t {
+            std::size_t count = 0;
+            for (const char* p = ptr_; p != ptr_ + length_; ++p) {
+                if (pred_(*p)) {
+                    ++count;
+                }
+            }
+            return count;
+        }
+        [[nodiscard]] constexpr auto empty() const -> bool {
+            return begin() == end();
+        }
+        [[nodiscard]] constexpr auto data() const noexcept -> const char* {
+            return ptr_;
+        }
+        [[nodiscard]] constexpr auto predicate() const noexcept -> const Pred& {
+            return pred_;
+        }
+
+        [[nodiscard]] constexpr auto begin() const -> const_iterator {
+            const char* p = ptr_;
+            while (p != ptr_ + length_ && !pred_(*p)) {
+                ++p;
+            }
+            return iter{p, ptr_ + length_, &pred_};
+        }
+        [[nodiscard]] constexpr auto end() const -> const_iterator {
+            return iter{ptr_ + length_, ptr_ + length_, &pred_};
+        }
+        [[nodiscard]] constexpr auto cbegin() const -> const_iterator {
+            return begin();
+        }
+        [[nodiscard]] constexpr auto cend() const -> const_iterator {
+            return end();
+        }
+        [[nodiscard]] constexpr auto rbegin() const -> const_reverse_iterator {
+            return const_reverse_iterator{end()};
+        }
+        [[nodiscard]] constexpr auto rend() const -> const_reverse_iterator {
+            return const_reverse_iterator{begin()};
+        }
+        [[nodiscard]] constexpr auto crbegin() const -> const_reverse_iterator {
+            return rbegin();
+        }
+        [[nodiscard]] constexpr auto crend() const -> const_reverse_iterator {
+            return rend();
+        }
+
+    private:
+        const char* ptr_ = nullptr;
+        std::size_t length_ = 0;
+        Pred pred_;
+
+        template<typename P, char_predicate... Filts>
+        friend constexpr auto compose(const basic_filtered_string_view<P>& fsv, Filts... filts)
+            -> basic_filtered_string_view<conjunction<Filts...>>;
+        template<typename P>
+        friend constexpr auto substr(const basic_filtered_string_view<P>& fsv,
+                                     std::size_t pos,
+                                     std::optional<std::size_t> count) -> basic_filtered_string_view<P>;
+    };
+
+    template<typename P1, typename P2>
+    constexpr auto operator<=>(const basic_filtered_string_view<P1>& lhs, const basic_filtered_string_view<P2>& rhs)
+        -> std::strong_ordering {
+        auto l = lhs.begin();
+        auto r = rhs.begin();
+        for (; l != lhs.end() && r != rhs.end(); ++l, ++r) {
+            if (*l != *r) {
+                return static_cast<unsigned char>(*l) <=> static_cast<unsigned char>(*r);
+            }
+        }
+        if (l != lhs.end()) {
+            return std::strong_ordering::greater;
+        }
+        if (r != rhs.end()) {
+            return std::strong_ordering::less;
+        }
+        return std::strong_ordering::equal;
+    }
+
+    template<typename P1, typename P2>
+    constexpr auto operator==(const basic_filtered_string_view<P1>& lhs, const basic_filtered_string_view<P2>& rhs)
+        -> bool {
+        return std::is_eq(lhs <=> rhs);
+    }
+
+    template<typename Pred>
+    auto operator<<(std::ostream& os, const basic_filtered_string_view<Pred>& fsv) -> std::ostream& {
+        for (const char c : fsv) {
+            os << c;
+        }
+        return os;
+    }
+
+    template<typename Pred, char_predicate... Filts>
+    constexpr auto compose(const basic_filtered_string_view<Pred>& fsv, Filts... filts)
+        -> basic_filtered_string_view<conjunction<Filts...>> {
+        return {fsv.ptr_, fsv.length_, conjunction<Filts...>{{std::move(filts)...}}};
+    }
+
+    template<typename Pred>
+    constexpr auto substr(const basic_filtered_string_view<Pred>& fsv,
+                          std::size_t pos,
+                          std::optional<std::size_t> count) -> basic_filtered_string_view<Pred> {
+        const auto fsv_size = fsv.size();
+        if (pos > fsv_size) {
+            throw std::out_of_range{"filtered_string_view::substr(" + std::to_string(pos)
+                                    + "): position out of range for filtered string of size "
+                                    + std::to_string(fsv_size)};
+        }
+        const auto end = count ? std::min(pos + *count, fsv_size) : fsv_size;
+        auto it = fsv.begin();
+        std::advance(it, pos);
+        const char* first = it == fsv.end() ? fsv.ptr_ + fsv.length_ : &*it;
+        std::advance(it, end - pos);
+        const char* last = it == fsv.end() ? fsv.ptr_ + fsv.length_ : &*it;
+        return {first, static_cast<std::size_t>(last - first), fsv.pred_};
+    }
+
+    // a view whose predicate is borrowed rather than owned; copies are a plain memcpy
+    using filtered_string_ref = basic_filtered_string_view<filter_ref>;
+} // namespace fsv
+
+#endif // COMP6771_ASS2_BASIC_FSV_H
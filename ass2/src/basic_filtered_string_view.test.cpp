@@ -0,0 +1,105 @@
+#include "./basic_filtered_string_view.h"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    constexpr auto is_upper = [](const char& c) { return c >= 'A' && c <= 'Z'; };
+    constexpr auto not_space = [](const char& c) { return c != ' '; };
+
+    constexpr auto initials = fsv::basic_filtered_string_view{"Portable Network Graphics", is_upper};
+
+    // a lookup table built entirely at compile time from a filtered literal
+    constexpr auto vowel_table = [] {
+        auto table = std::array<bool, 256>{};
+        for (const char c : fsv::basic_filtered_string_view{"a e i o u", not_space}) {
+            table[static_cast<unsigned char>(c)] = true;
+        }
+        return table;
+    }();
+} // namespace
+
+TEST_CASE("constexpr construction, size and indexing") {
+    static_assert(initials.size() == 3);
+    static_assert(!initials.empty());
+    static_assert(initials[0] == 'P' && initials[1] == 'N' && initials[2] == 'G');
+    static_assert(initials.at(2) == 'G');
+    static_assert(fsv::basic_filtered_string_view{"abc"}.size() == 3);
+    static_assert(fsv::basic_filtered_string_view<>{}.empty());
+    static_assert(vowel_table['e'] && !vowel_table[' '] && !vowel_table['b']);
+
+    REQUIRE(static_cast<std::string>(initials) == "PNG");
+    REQUIRE_THROWS_WITH(initials.at(3), "filtered_string_view::at(3): invalid index");
+}
+
+TEST_CASE("constexpr iteration") {
+    static_assert(std::bidirectional_iterator<decltype(initials)::iterator>);
+    static_assert(std::ranges::equal(initials, std::string_view{"PNG"}));
+    static_assert(*std::prev(initials.end()) == 'G');
+    static_assert(*initials.rbegin() == 'G');
+    REQUIRE(std::string(initials.rbegin(), initials.rend()) == "GNP");
+}
+
+TEST_CASE("constexpr comparisons") {
+    constexpr auto spaced = fsv::basic_filtered_string_view{"P N G", not_space};
+    static_assert(initials == spaced);
+    static_assert(initials < fsv::basic_filtered_string_view{"PNGs"});
+    static_assert((fsv::basic_filtered_string_view{"b"} <=> initials) == std::strong_ordering::greater);
+    static_assert(fsv::basic_filtered_string_view<>{} == fsv::basic_filtered_string_view{"   ", is_upper});
+}
+
+TEST_CASE("constexpr compose and substr") {
+    constexpr auto composed = fsv::compose(fsv::basic_filtered_string_view{"c / c++"},
+                                           [](const char& c) { return c == 'c' || c == '+' || c == '/'; },
+                                           [](const char& c) { return c > ' '; });
+    static_assert(composed == fsv::basic_filtered_string_view{"c/c++"});
+    static_assert(composed.data()[1] == ' ');
+
+    constexpr auto city = fsv::basic_filtered_string_view{"new york city"};
+    static_assert(fsv::substr(city, 4, 4) == fsv::basic_filtered_string_view{"york"});
+    static_assert(fsv::substr(city, 9) == fsv::basic_filtered_string_view{"city"});
+    static_assert(fsv::substr(city, 13).empty());
+    static_assert(fsv::substr(initials, 1, 1) == fsv::basic_filtered_string_view{"N"});
+
+    REQUIRE_THROWS_WITH(fsv::substr(initials, 4),
+                        "filtered_string_view::substr(4): position out of range for filtered string of size 3");
+}
+
+TEST_CASE("conversion to the runtime view and output") {
+    constexpr auto letters = fsv::basic_filtered_string_view{"c-l-a-s-s", fsv::char_class{"acls"}};
+    auto runtime = static_cast<fsv::filtered_string_view>(letters);
+    REQUIRE(runtime == fsv::filtered_string_view{"class"});
+    REQUIRE(runtime.predicate().target<fsv::char_class>() != nullptr);
+
+    auto oss = std::ostringstream{};
+    oss << initials;
+    REQUIRE(oss.str() == "PNG");
+}
+
+TEST_CASE("filtered_string_ref borrows its predicate") {
+    static_assert(std::is_trivially_copyable_v<fsv::filtered_string_ref>);
+    static_assert(sizeof(fsv::filtered_string_ref) < sizeof(fsv::filtered_string_view));
+    static_assert(!std::is_constructible_v<fsv::filter_ref, decltype(not_space)&&>);
+
+    auto calls = 0;
+    auto counting_upper = [&calls](const char& c) {
+        ++calls;
+        return is_upper(c);
+    };
+    const auto text = std::string{"Portable Network Graphics"};
+    auto views = std::vector<fsv::filtered_string_ref>(3, fsv::filtered_string_ref{text.data(), counting_upper});
+    REQUIRE(static_cast<std::string>(views.back()) == "PNG");
+    REQUIRE(calls >= static_cast<int>(text.size()));
+
+    // the runtime view stores the reference without taking a copy of the closure
+    const auto before = calls;
+    auto runtime = fsv::filtered_string_view{text.data(), fsv::filter_ref{counting_upper}};
+    REQUIRE(runtime.size() == 3);
+    REQUIRE(calls > before);
+    REQUIRE(fsv::substr(views[0], 1) == fsv::basic_filtered_string_view{"NG"});
+}
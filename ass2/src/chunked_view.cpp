@@ -0,0 +1,198 @@
+#include "./chunked_view.h"
+#include "./instrument.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fsv {
+    namespace {
+        auto round_to_pages(std::size_t n) -> std::size_t {
+            const auto page_size = ::sysconf(_SC_PAGESIZE);
+            const auto page = page_size > 0 ? static_cast<std::size_t>(page_size) : std::size_t{4096};
+            return std::max(page, (n + page - 1) / page * page);
+        }
+
+        [[noreturn]] auto throw_errno(int fd, const std::string& what) -> void {
+            const auto err = errno;
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            throw std::system_error{err, std::generic_category(), what};
+        }
+    } // namespace
+
+    mapped_file::mapped_file(const std::filesystem::path& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw_errno(fd, "mapped_file: cannot open " + path.string());
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            throw_errno(fd, "mapped_file: cannot stat " + path.string());
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ != 0) {
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                throw_errno(fd, "mapped_file: cannot map " + path.string());
+            }
+            data_ = static_cast<const char*>(p);
+        }
+        ::close(fd);
+    }
+
+    mapped_file::mapped_file(mapped_file&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0)) {}
+
+    mapped_file::~mapped_file() {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    auto mapped_file::operator=(mapped_file&& other) noexcept -> mapped_file& {
+        if (this != &other) {
+            if (data_ != nullptr) {
+                ::munmap(const_cast<char*>(data_), size_);
+            }
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    auto mapped_file::data() const noexcept -> const char* {
+        return data_;
+    }
+
+    auto mapped_file::size() const noexcept -> std::size_t {
+        return size_;
+    }
+
+    chunked_view::chunked_view(const char* data,
+                               std::size_t len,
+                               filter predicate,
+                               std::size_t threads,
+                               std::size_t chunk_size)
+    : data_(data)
+    , length_(len)
+    , pred_(std::move(predicate))
+    , chunk_size_(round_to_pages(chunk_size)) {
+        build_index(threads);
+    }
+
+    chunked_view::chunked_view(const std::filesystem::path& path,
+                               filter predicate,
+                               std::size_t threads,
+                               std::size_t chunk_size)
+    : file_(std::make_shared<const mapped_file>(path))
+    , data_(file_->data())
+    , length_(file_->size())
+    , pred_(std::move(predicate))
+    , chunk_size_(round_to_pages(chunk_size)) {
+        build_index(threads);
+    }
+
+    // Workers claim chunks from a shared counter and each writes only its own chunk's slot, so the
+    // counting needs no locking; the calling thread takes part and the prefix sum is done after joining.
+    auto chunked_view::build_index(std::size_t threads) -> void {
+        FSV_INSTRUMENT_COUNT(index_builds, 1);
+        const auto chunks = (length_ + chunk_size_ - 1) / chunk_size_;
+        prefix_.assign(chunks + 1, 0);
+        if (threads == 0) {
+            threads = std::max(1U, std::thread::hardware_concurrency());
+        }
+        threads = std::min(threads, chunks);
+
+        auto next = std::atomic<std::size_t>{0};
+        auto error = std::exception_ptr{};
+        auto error_mutex = std::mutex{};
+        auto count_chunks = [&] {
+            try {
+                for (auto i = next.fetch_add(1); i < chunks; i = next.fetch_add(1)) {
+                    prefix_[i + 1] = chunk(i).size();
+                }
+            } catch (...) {
+                const auto lock = std::scoped_lock{error_mutex};
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next = chunks;
+            }
+        };
+        {
+            auto pool = std::vector<std::jthread>{};
+            for (std::size_t t = 1; t < threads; ++t) {
+                pool.emplace_back(count_chunks);
+            }
+            count_chunks();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        std::partial_sum(prefix_.begin(), prefix_.end(), prefix_.begin());
+    }
+
+    // size() is O(1) here, so unlike filtered_string_view::operator[] this checks its argument.
+    // The chunk is scanned in place with pred_ rather than through chunk(), which copies it.
+    auto chunked_view::operator[](std::size_t n) const -> const char& {
+        if (n >= size()) {
+            throw std::domain_error{"chunked_view::operator[](" + std::to_string(n) + "): invalid index"};
+        }
+        const auto it = std::upper_bound(prefix_.begin(), prefix_.end(), n);
+        const auto i = static_cast<std::size_t>(it - prefix_.begin()) - 1;
+        const char* first = data_ + i * chunk_size_;
+        auto skip = n - prefix_[i];
+        for (const char* p = first;; ++p) {
+            if (pred_(*p)) {
+                if (skip == 0) {
+                    FSV_INSTRUMENT_COUNT(predicate_calls, static_cast<std::size_t>(p - first) + 1);
+                    return *p;
+                }
+                --skip;
+            }
+        }
+    }
+
+    auto chunked_view::at(std::size_t index) const -> const char& {
+        if (index >= size()) {
+            throw std::domain_error{"chunked_view::at(" + std::to_string(index) + "): invalid index"};
+        }
+        return (*this)[index];
+    }
+
+    auto chunked_view::size() const noexcept -> std::size_t {
+        return prefix_.back();
+    }
+
+    auto chunked_view::empty() const noexcept -> bool {
+        return size() == 0;
+    }
+
+    auto chunked_view::chunk_count() const noexcept -> std::size_t {
+        return prefix_.size() - 1;
+    }
+
+    auto chunked_view::view() const -> filtered_string_view {
+        return filtered_string_view{data_, length_, pred_};
+    }
+
+    auto chunked_view::chunk(std::size_t i) const -> filtered_string_view {
+        const auto offset = i * chunk_size_;
+        return filtered_string_view{data_ + offset, std::min(chunk_size_, length_ - offset), pred_};
+    }
+} // namespace fsv
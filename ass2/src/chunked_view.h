@@ -0,0 +1,77 @@
+#ifndef COMP6771_ASS2_CHUNKED_VIEW_H
+#define COMP6771_ASS2_CHUNKED_VIEW_H
+
+#include "./filtered_string_view.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace fsv {
+    // A read-only memory mapping of a whole file.
+    class mapped_file {
+    public:
+        explicit mapped_file(const std::filesystem::path& path);
+        mapped_file(const mapped_file& other) = delete;
+        mapped_file(mapped_file&& other) noexcept;
+        ~mapped_file();
+
+        auto operator=(const mapped_file& other) -> mapped_file& = delete;
+        auto operator=(mapped_file&& other) noexcept -> mapped_file&;
+
+        [[nodiscard]] auto data() const noexcept -> const char*;
+        [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+    private:
+        const char* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+    // A filtered view over a large buffer whose index is built in parallel.
+    // The buffer is cut into page-aligned chunks, the predicate is run over the chunks on a pool of
+    // threads, and the per-chunk counts are stitched into prefix sums. size() is then O(1) and
+    // indexing only rescans the single chunk that holds the character.
+    // The predicate is called concurrently, so it must be safe to call from several threads.
+    class chunked_view {
+    public:
+        // `threads == 0` uses one thread per hardware core; `chunk_size` is rounded up to whole pages
+        chunked_view(const char* data,
+                     std::size_t len,
+                     filter predicate,
+                     std::size_t threads = 0,
+                     std::size_t chunk_size = default_chunk_size);
+        // maps the file at `path`, which the view keeps alive
+        chunked_view(const std::filesystem::path& path,
+                     filter predicate,
+                     std::size_t threads = 0,
+                     std::size_t chunk_size = default_chunk_size);
+
+        // both throw std::domain_error if the index is not less than size()
+        auto operator[](std::size_t n) const -> const char&;
+        auto at(std::size_t index) const -> const char&;
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t;
+        [[nodiscard]] auto empty() const noexcept -> bool;
+        [[nodiscard]] auto chunk_count() const noexcept -> std::size_t;
+
+        // the whole buffer, or the i-th chunk, as an ordinary filtered_string_view
+        [[nodiscard]] auto view() const -> filtered_string_view;
+        [[nodiscard]] auto chunk(std::size_t i) const -> filtered_string_view;
+
+        static constexpr std::size_t default_chunk_size = std::size_t{1} << 20U;
+
+    private:
+        auto build_index(std::size_t threads) -> void;
+
+        std::shared_ptr<const mapped_file> file_;
+        const char* data_;
+        std::size_t length_;
+        filter pred_;
+        std::size_t chunk_size_;
+        // prefix_[i] is the number of passing characters in the chunks before chunk i
+        std::vector<std::size_t> prefix_;
+    };
+} // namespace fsv
+
+#endif // COMP6771_ASS2_CHUNKED_VIEW_H
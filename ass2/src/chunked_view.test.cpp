@@ -0,0 +1,78 @@
+#include "./chunked_view.h"
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+    auto make_text(std::size_t n) -> std::string {
+        auto text = std::string(n, ' ');
+        for (std::size_t i = 0; i < n; ++i) {
+            text[i] = static_cast<char>('a' + static_cast<char>(i * 7 % 26));
+        }
+        return text;
+    }
+} // namespace
+
+TEST_CASE("chunked_view over memory") {
+    const auto text = make_text(20000);
+    auto is_vowel = [](const char& c) { return c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u'; };
+    auto plain = fsv::filtered_string_view{text, is_vowel};
+    auto chunked = fsv::chunked_view{text.data(), text.size(), is_vowel, 4, 1};
+
+    REQUIRE(chunked.chunk_count() > 1);
+    REQUIRE(chunked.size() == plain.size());
+    REQUIRE_FALSE(chunked.empty());
+    REQUIRE(chunked.view() == plain);
+    for (std::size_t i = 0; i < chunked.size(); i += 97) {
+        REQUIRE(&chunked[i] == &plain[i]);
+    }
+    REQUIRE(&chunked.at(chunked.size() - 1) == &plain[plain.size() - 1]);
+    REQUIRE_THROWS_WITH(chunked.at(chunked.size()),
+                        "chunked_view::at(" + std::to_string(chunked.size()) + "): invalid index");
+    REQUIRE_THROWS_WITH(chunked[chunked.size()],
+                        "chunked_view::operator[](" + std::to_string(chunked.size()) + "): invalid index");
+}
+
+TEST_CASE("chunked_view with chunks that have no passing characters") {
+    auto text = std::string(10000, '.');
+    text[9999] = 'x';
+    auto chunked = fsv::chunked_view{text.data(), text.size(), fsv::char_class{"x"}, 2, 1};
+    REQUIRE(chunked.size() == 1);
+    REQUIRE(&chunked[0] == &text[9999]);
+    REQUIRE_THROWS_AS(chunked[1], std::domain_error);
+
+    auto nothing = fsv::chunked_view{text.data(), 0, fsv::filtered_string_view::default_predicate};
+    REQUIRE(nothing.empty());
+    REQUIRE(nothing.chunk_count() == 0);
+}
+
+TEST_CASE("chunked_view over a mapped file") {
+    const auto text = make_text(50000);
+    const auto path = std::filesystem::temp_directory_path() / "chunked_view_test.txt";
+    {
+        auto out = std::ofstream{path, std::ios::binary};
+        out << text;
+    }
+    {
+        auto chunked = fsv::chunked_view{path, [](const char& c) { return c != 'q'; }, 0, 4096};
+        auto plain = fsv::filtered_string_view{text, [](const char& c) { return c != 'q'; }};
+        REQUIRE(chunked.size() == plain.size());
+        REQUIRE(chunked[12345] == plain[12345]);
+        REQUIRE(static_cast<std::string>(chunked.view()) == static_cast<std::string>(plain));
+    }
+    std::filesystem::remove(path);
+
+    REQUIRE_THROWS_AS(fsv::chunked_view(path, fsv::filtered_string_view::default_predicate), std::system_error);
+}
+
+TEST_CASE("chunked_view propagates predicate exceptions") {
+    const auto text = make_text(10000);
+    auto throwing = [](const char& c) {
+        if (c == 'z') {
+            throw std::runtime_error{"bad char"};
+        }
+        return true;
+    };
+    REQUIRE_THROWS_WITH((fsv::chunked_view{text.data(), text.size(), throwing, 3, 1}), "bad char");
+}
@@ -0,0 +1,93 @@
+#ifndef COMP6771_ASS2_FILTER_EXPR_H
+#define COMP6771_ASS2_FILTER_EXPR_H
+
+#include "./basic_filtered_string_view.h"
+#include "./filtered_string_view.h"
+
+#include <type_traits>
+#include <utility>
+
+// Predicate expressions: wrap callables with fsv::pred() and combine them with &&, || and !.
+// The result is a single predicate type built at compile time, so the whole expression is inlined
+// into one call instead of looping over a vector of std::function:
+//     auto letters = fsv::pred(is_alpha) && !fsv::char_class{"xyz"};
+//     auto view = fsv::compose(text, letters);
+// char_class operands combine into another char_class (see filtered_string_view.h).
+// Plain lambdas must be wrapped first: `lambda1 && lambda2` would convert both to bool.
+namespace fsv {
+    template<char_predicate F>
+    struct pred_expr {
+        F f;
+
+        constexpr auto operator()(const char& c) const -> bool {
+            return f(c);
+        }
+    };
+
+    template<char_predicate L, char_predicate R>
+    struct and_expr {
+        L lhs;
+        R rhs;
+
+        constexpr auto operator()(const char& c) const -> bool {
+            return lhs(c) && rhs(c);
+        }
+    };
+
+    template<char_predicate L, char_predicate R>
+    struct or_expr {
+        L lhs;
+        R rhs;
+
+        constexpr auto operator()(const char& c) const -> bool {
+            return lhs(c) || rhs(c);
+        }
+    };
+
+    template<char_predicate P>
+    struct not_expr {
+        P p;
+
+        constexpr auto operator()(const char& c) const -> bool {
+            return !p(c);
+        }
+    };
+
+    template<typename T>
+    inline constexpr bool is_filter_expression_v = false;
+    template<typename F>
+    inline constexpr bool is_filter_expression_v<pred_expr<F>> = true;
+    template<typename L, typename R>
+    inline constexpr bool is_filter_expression_v<and_expr<L, R>> = true;
+    template<typename L, typename R>
+    inline constexpr bool is_filter_expression_v<or_expr<L, R>> = true;
+    template<typename P>
+    inline constexpr bool is_filter_expression_v<not_expr<P>> = true;
+    template<>
+    inline constexpr bool is_filter_expression_v<char_class> = true;
+
+    template<typename T>
+    concept filter_expression = is_filter_expression_v<std::remove_cvref_t<T>>;
+
+    template<char_predicate F>
+    constexpr auto pred(F f) -> pred_expr<F> {
+        return pred_expr<F>{std::move(f)};
+    }
+
+    template<filter_expression L, filter_expression R>
+    constexpr auto operator&&(L lhs, R rhs) -> and_expr<L, R> {
+        return and_expr<L, R>{std::move(lhs), std::move(rhs)};
+    }
+
+    template<filter_expression L, filter_expression R>
+    constexpr auto operator||(L lhs, R rhs) -> or_expr<L, R> {
+        return or_expr<L, R>{std::move(lhs), std::move(rhs)};
+    }
+
+    template<filter_expression P>
+    constexpr auto operator!(P p) -> not_expr<P> {
+        return not_expr<P>{std::move(p)};
+    }
+} // namespace fsv
+
+#endif // COMP6771_ASS2_FILTER_EXPR_H
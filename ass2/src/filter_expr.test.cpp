@@ -0,0 +1,62 @@
+#include "./filter_expr.h"
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr auto is_lower = fsv::pred([](const char& c) { return c >= 'a' && c <= 'z'; });
+    constexpr auto is_digit = fsv::pred([](const char& c) { return c >= '0' && c <= '9'; });
+} // namespace
+
+TEST_CASE("composing predicate expressions") {
+    auto text = fsv::filtered_string_view{"abc 123 XYZ xyz!"};
+
+    SECTION("and, or, not") {
+        REQUIRE(static_cast<std::string>(fsv::compose(text, is_lower || is_digit)) == "abc123xyz");
+        REQUIRE(static_cast<std::string>(fsv::compose(text, is_lower && !fsv::char_class{"by"})) == "acxz");
+        REQUIRE(static_cast<std::string>(fsv::compose(text, !(is_lower || is_digit) && !fsv::char_class{" "}))
+                == "XYZ!");
+    }
+
+    SECTION("agrees with the vector overload") {
+        auto vf = std::vector<fsv::filter>{is_lower, [](const char& c) { return c != 'b'; }};
+        auto fused = is_lower && fsv::pred([](const char& c) { return c != 'b'; });
+        REQUIRE(fsv::compose(text, vf) == fsv::compose(text, fused));
+    }
+
+    SECTION("short-circuits left to right") {
+        auto calls = 0;
+        auto counted = fsv::pred([&calls](const char&) {
+            ++calls;
+            return true;
+        });
+        auto none = fsv::pred([](const char&) { return false; });
+        REQUIRE(fsv::compose(text, none && counted).empty());
+        REQUIRE(calls == 0);
+        REQUIRE(fsv::compose(text, !none || counted).size() == 16);
+        REQUIRE(calls == 0);
+    }
+
+    SECTION("ignores the original predicate and keeps the original extent") {
+        auto source = std::string{"a1b2c3"};
+        auto prefix = fsv::filtered_string_view{source.data(), 4, [](const char&) { return false; }};
+        REQUIRE(static_cast<std::string>(fsv::compose(prefix, is_digit)) == "12");
+    }
+}
+
+TEST_CASE("char_class expressions stay char_class") {
+    auto vowels = fsv::char_class{"aeiou"};
+    auto fused = (vowels || fsv::char_class{"y"}) && !fsv::char_class{"a"};
+    static_assert(std::is_same_v<decltype(fused), fsv::char_class>);
+
+    auto view = fsv::compose(fsv::filtered_string_view{"yesterday, a sunny day"}, fused);
+    REQUIRE(view.predicate().target<fsv::char_class>() != nullptr);
+    REQUIRE(static_cast<std::string>(view) == "yeeyuyy");
+}
+
+TEST_CASE("expressions are constexpr") {
+    constexpr auto alnum = is_lower || is_digit;
+    static_assert(alnum('q') && alnum('7') && !alnum('Q'));
+    constexpr auto view = fsv::basic_filtered_string_view{"R2-D2 & c-3po", alnum};
+    static_assert(view == fsv::basic_filtered_string_view{"22c3po"});
+}
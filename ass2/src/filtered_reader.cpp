@@ -0,0 +1,63 @@
+#include "./filtered_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include <utility>
+
+namespace fsv {
+    filtered_reader::filtered_reader(std::istream& in, filter predicate, std::size_t block_size)
+    : in_(&in)
+    , pred_(std::move(predicate))
+    , buffer_(std::max(block_size, std::size_t{1})) {}
+
+    // reads the next block and compacts its passing characters to the front; false at the end
+    auto filtered_reader::fill() -> bool {
+        pos_ = 0;
+        end_ = 0;
+        while (end_ == 0 && *in_) {
+            in_->read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+            if (in_->bad()) {
+                throw std::ios_base::failure{"filtered_reader: stream read failed"};
+            }
+            const auto n = static_cast<std::size_t>(in_->gcount());
+            const auto block = filtered_string_view{buffer_.data(), n, pred_};
+            const char* last = buffer_.data() + n;
+            for (auto [first, run_end] = block.next_run(buffer_.data()); first != last;
+                 std::tie(first, run_end) = block.next_run(run_end)) {
+                const auto len = static_cast<std::size_t>(run_end - first);
+                std::memmove(buffer_.data() + end_, first, len);
+                end_ += len;
+            }
+        }
+        return end_ != 0;
+    }
+
+    auto filtered_reader::available() -> bool {
+        return pos_ != end_ || fill();
+    }
+
+    auto filtered_reader::read(std::span<char> out) -> std::size_t {
+        std::size_t copied = 0;
+        while (copied != out.size() && available()) {
+            const auto n = std::min(out.size() - copied, end_ - pos_);
+            std::memcpy(out.data() + copied, buffer_.data() + pos_, n);
+            pos_ += n;
+            copied += n;
+        }
+        return copied;
+    }
+
+    auto filtered_reader::eof() -> bool {
+        return !available();
+    }
+
+    auto filtered_reader::begin() -> iterator {
+        available();
+        return iter{this};
+    }
+
+    auto filtered_reader::end() const noexcept -> std::default_sentinel_t {
+        return std::default_sentinel;
+    }
+} // namespace fsv
@@ -0,0 +1,93 @@
+#ifndef COMP6771_ASS2_FILTERED_READER_H
+#define COMP6771_ASS2_FILTERED_READER_H
+
+#include "./filtered_string_view.h"
+
+#include <cstddef>
+#include <istream>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace fsv {
+    // Applies a filter to a stream. Blocks of `block_size` characters are read from the stream and
+    // filtered in place a run at a time, as filtered_string_view does in memory, so memory use is
+    // bounded by one block whatever the length of the stream. The passing characters are available
+    // through read() and as an input range; the two may be mixed.
+    //
+    // A block read waits until the block is full or the stream ends. Throws std::ios_base::failure
+    // if the stream goes bad.
+    class filtered_reader {
+        class iter {
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = char;
+            using reference = const char&;
+            using difference_type = std::ptrdiff_t;
+
+            iter() = default;
+
+            auto operator*() const -> reference {
+                return reader_->buffer_[reader_->pos_];
+            }
+            auto operator++() -> iter& {
+                ++reader_->pos_;
+                reader_->available();
+                return *this;
+            }
+            auto operator++(int) -> void {
+                ++*this;
+            }
+
+            friend auto operator==(const iter& it, std::default_sentinel_t) -> bool {
+                return it.done();
+            }
+
+        private:
+            explicit iter(filtered_reader* reader)
+            : reader_(reader) {}
+
+            // the buffer is refilled eagerly, so an empty buffer means the stream is exhausted
+            auto done() const -> bool {
+                return reader_->pos_ == reader_->end_;
+            }
+
+            filtered_reader* reader_ = nullptr;
+
+            friend class filtered_reader;
+        };
+
+    public:
+        static constexpr std::size_t default_block_size = std::size_t{64} * 1024;
+
+        explicit filtered_reader(std::istream& in,
+                                 filter predicate = filtered_string_view::default_predicate,
+                                 std::size_t block_size = default_block_size);
+
+        // copies passing characters into `out` until it is full or the stream ends; returns how many
+        // were copied, which is less than out.size() only at the end of the stream
+        auto read(std::span<char> out) -> std::size_t;
+        // whether the stream is exhausted, reading a block if needed to find out
+        [[nodiscard]] auto eof() -> bool;
+
+        using iterator = iter;
+
+        // the reader is its own position: begin() may be called again to resume where a previous
+        // iteration or read() stopped
+        [[nodiscard]] auto begin() -> iterator;
+        [[nodiscard]] auto end() const noexcept -> std::default_sentinel_t;
+
+    private:
+        // whether a passing character is buffered, reading blocks until one is or the stream ends
+        auto available() -> bool;
+        auto fill() -> bool;
+
+        std::istream* in_;
+        filter pred_;
+        std::vector<char> buffer_;
+        std::size_t pos_ = 0;
+        std::size_t end_ = 0;
+    };
+} // namespace fsv
+
+#endif // COMP6771_ASS2_FILTERED_READER_H
@@ -0,0 +1,105 @@
+#include "./filtered_reader.h"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <sstream>
+#include <streambuf>
+#include <string>
+
+namespace {
+    auto const no_vowels = [](const char& c) { return std::string{"aeiou"}.find(c) == std::string::npos; };
+
+    auto read_all(fsv::filtered_reader& reader, std::size_t chunk) -> std::string {
+        auto result = std::string{};
+        auto buf = std::string(chunk, '\0');
+        while (auto n = reader.read(buf)) {
+            result.append(buf.data(), n);
+        }
+        return result;
+    }
+
+    auto collect(fsv::filtered_reader& reader) -> std::string {
+        auto result = std::string{};
+        for (auto c : reader) {
+            result += c;
+        }
+        return result;
+    }
+
+    auto long_text() -> std::string {
+        auto text = std::string{};
+        for (auto i = 0; i < 500; ++i) {
+            text += "the quick brown fox " + std::to_string(i) + "\n";
+        }
+        return text;
+    }
+
+    class failing_buffer : public std::streambuf {
+    protected:
+        auto underflow() -> int_type override {
+            throw std::runtime_error{"device error"};
+        }
+    };
+} // namespace
+
+TEST_CASE("filtered_reader read()") {
+    const auto text = long_text();
+    const auto expected = static_cast<std::string>(fsv::filtered_string_view{text, no_vowels});
+
+    const auto block_sizes = {std::size_t{1}, std::size_t{7}, std::size_t{64},
+                              fsv::filtered_reader::default_block_size};
+    for (auto block_size : block_sizes) {
+        for (auto chunk : {std::size_t{1}, std::size_t{5}, std::size_t{4096}}) {
+            auto in = std::istringstream{text};
+            auto reader = fsv::filtered_reader{in, no_vowels, block_size};
+            REQUIRE(read_all(reader, chunk) == expected);
+            REQUIRE(reader.eof());
+        }
+    }
+}
+
+TEST_CASE("filtered_reader as an input range") {
+    static_assert(std::ranges::input_range<fsv::filtered_reader>);
+    auto in = std::istringstream{"a1b2c3 d4"};
+    auto reader = fsv::filtered_reader{in, fsv::char_class{"0123456789"}, 2};
+    REQUIRE(collect(reader) == "1234");
+    REQUIRE(reader.eof());
+
+    SECTION("default predicate and ranges algorithms") {
+        const auto text = long_text();
+        auto text_in = std::istringstream{text};
+        auto all = fsv::filtered_reader{text_in};
+        REQUIRE(std::ranges::count(all, '\n') == 500);
+    }
+
+    SECTION("mixing iteration and read()") {
+        auto mixed_in = std::istringstream{"abcdefgh"};
+        auto mixed = fsv::filtered_reader{mixed_in, [](const char& c) { return c != 'c'; }, 3};
+        auto it = mixed.begin();
+        REQUIRE(*it == 'a');
+        ++it;
+        auto buf = std::array<char, 3>{};
+        REQUIRE(mixed.read(buf) == 3);
+        REQUIRE(std::string(buf.begin(), buf.end()) == "bde");
+        REQUIRE(collect(mixed) == "fgh");
+    }
+}
+
+TEST_CASE("filtered_reader edge cases") {
+    auto empty_in = std::istringstream{""};
+    auto empty = fsv::filtered_reader{empty_in};
+    REQUIRE(empty.eof());
+    REQUIRE(empty.begin() == empty.end());
+
+    // whole blocks that filter to nothing are skipped over
+    auto spaces_in = std::istringstream{std::string(100, ' ') + "x" + std::string(100, ' ')};
+    auto spaces = fsv::filtered_reader{spaces_in, [](const char& c) { return c != ' '; }, 8};
+    REQUIRE(read_all(spaces, 16) == "x");
+
+    auto buf = failing_buffer{};
+    auto failing_in = std::istream{&buf};
+    failing_in.exceptions(std::ios_base::badbit);
+    auto failing = fsv::filtered_reader{failing_in};
+    REQUIRE_THROWS_WITH(failing.eof(), "device error");
+}
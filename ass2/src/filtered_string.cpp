@@ -0,0 +1,93 @@
+#include "./filtered_string.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace fsv {
+    namespace {
+        const auto empty_text = std::string{};
+
+        // not a namespace-scope constant: the default predicate lives in another translation unit
+        auto empty_hash() -> std::size_t {
+            static const auto h = hash{}(filtered_string_view{});
+            return h;
+        }
+    } // namespace
+
+    filtered_string::filtered_string(const filtered_string_view& fsv)
+    : filtered_string(static_cast<std::string>(fsv)) {}
+
+    filtered_string::filtered_string(std::string str) {
+        const auto h = hash{}(str);
+        buf_ = std::make_shared<const buffer>(buffer{std::move(str), h});
+    }
+
+    auto filtered_string::data() const noexcept -> const char* {
+        return str().c_str();
+    }
+
+    auto filtered_string::size() const noexcept -> std::size_t {
+        return str().size();
+    }
+
+    auto filtered_string::empty() const noexcept -> bool {
+        return str().empty();
+    }
+
+    auto filtered_string::str() const noexcept -> const std::string& {
+        return buf_ == nullptr ? empty_text : buf_->text;
+    }
+
+    auto filtered_string::operator[](std::size_t n) const noexcept -> const char& {
+        return str()[n];
+    }
+
+    auto filtered_string::at(std::size_t index) const -> const char& {
+        if (index >= size()) {
+            throw std::domain_error{"filtered_string::at(" + std::to_string(index) + "): invalid index"};
+        }
+        return str()[index];
+    }
+
+    auto filtered_string::begin() const noexcept -> const char* {
+        return data();
+    }
+
+    auto filtered_string::end() const noexcept -> const char* {
+        return data() + size();
+    }
+
+    filtered_string::operator filtered_string_view() const {
+        return filtered_string_view{data(), size(), filtered_string_view::default_predicate};
+    }
+
+    filtered_string::operator std::string_view() const noexcept {
+        return str();
+    }
+
+    filtered_string::operator std::string() const {
+        return str();
+    }
+
+    auto operator==(const filtered_string& lhs, const filtered_string& rhs) noexcept -> bool {
+        if (lhs.buf_ == rhs.buf_) {
+            return true;
+        }
+        return fsv::hash{}(lhs) == fsv::hash{}(rhs) && lhs.str() == rhs.str();
+    }
+
+    auto operator<=>(const filtered_string& lhs, const filtered_string& rhs) noexcept -> std::strong_ordering {
+        if (lhs.buf_ == rhs.buf_) {
+            return std::strong_ordering::equal;
+        }
+        return lhs.str() <=> rhs.str();
+    }
+
+    auto operator<<(std::ostream& os, const filtered_string& str) -> std::ostream& {
+        return os << str.str();
+    }
+
+    auto hash::operator()(const filtered_string& str) const noexcept -> std::size_t {
+        return str.buf_ == nullptr ? empty_hash() : str.buf_->hash;
+    }
+} // namespace fsv
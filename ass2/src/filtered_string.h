@@ -0,0 +1,64 @@
+#ifndef COMP6771_ASS2_FILTERED_STRING_H
+#define COMP6771_ASS2_FILTERED_STRING_H
+
+#include "./filtered_string_view.h"
+
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace fsv {
+    // An owning, immutable companion to filtered_string_view. The filtered text (and its hash) is
+    // computed once into a shared buffer; copies share it, so using the result as a map key, logging
+    // it or comparing it never runs the predicate again. Converting back to a filtered_string_view
+    // gives an unfiltered view over the buffer, valid for as long as some copy of the string lives.
+    class filtered_string {
+    public:
+        filtered_string() noexcept = default;
+        explicit filtered_string(const filtered_string_view& fsv);
+        explicit filtered_string(std::string str);
+
+        // contiguous and null-terminated
+        [[nodiscard]] auto data() const noexcept -> const char*;
+        [[nodiscard]] auto size() const noexcept -> std::size_t;
+        [[nodiscard]] auto empty() const noexcept -> bool;
+        [[nodiscard]] auto str() const noexcept -> const std::string&;
+
+        auto operator[](std::size_t n) const noexcept -> const char&;
+        auto at(std::size_t index) const -> const char&;
+
+        [[nodiscard]] auto begin() const noexcept -> const char*;
+        [[nodiscard]] auto end() const noexcept -> const char*;
+
+        operator filtered_string_view() const;
+        operator std::string_view() const noexcept;
+        explicit operator std::string() const;
+
+        friend auto operator==(const filtered_string& lhs, const filtered_string& rhs) noexcept -> bool;
+        friend auto operator<=>(const filtered_string& lhs, const filtered_string& rhs) noexcept
+            -> std::strong_ordering;
+        friend auto operator<<(std::ostream& os, const filtered_string& str) -> std::ostream&;
+        friend struct hash;
+
+    private:
+        struct buffer {
+            std::string text;
+            std::size_t hash;
+        };
+
+        std::shared_ptr<const buffer> buf_;
+    };
+} // namespace fsv
+
+template<>
+struct std::hash<fsv::filtered_string> {
+    auto operator()(const fsv::filtered_string& str) const noexcept -> std::size_t {
+        return fsv::hash{}(str);
+    }
+};
+
+#endif // COMP6771_ASS2_FILTERED_STRING_H
@@ -0,0 +1,85 @@
+#include "./filtered_string.h"
+#include <catch2/catch.hpp>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace {
+    auto const no_vowels = [](const char& c) { return std::string_view{"aeiou"}.find(c) == std::string_view::npos; };
+} // namespace
+
+TEST_CASE("filtered_string materialises once") {
+    auto calls = 0;
+    auto counting = [&calls](const char& c) {
+        ++calls;
+        return no_vowels(c);
+    };
+    const auto source = std::string{"materialise"};
+    auto str = fsv::filtered_string{fsv::filtered_string_view{source, counting}};
+    const auto after_build = calls;
+
+    REQUIRE(str.str() == "mtrls");
+    REQUIRE(str.size() == 5);
+    REQUIRE(std::string{str.data()} == "mtrls");
+    REQUIRE(static_cast<std::string>(str) == "mtrls");
+    REQUIRE(std::string_view{str} == "mtrls");
+    REQUIRE(str[1] == 't');
+    REQUIRE(str.at(4) == 's');
+    REQUIRE_THROWS_WITH(str.at(5), "filtered_string::at(5): invalid index");
+    REQUIRE(std::string(str.begin(), str.end()) == "mtrls");
+
+    auto view = static_cast<fsv::filtered_string_view>(str);
+    REQUIRE(view == fsv::filtered_string_view{"mtrls"});
+    REQUIRE(view.data() == str.data());
+
+    auto oss = std::ostringstream{};
+    oss << str;
+    REQUIRE(oss.str() == "mtrls");
+    REQUIRE(calls == after_build);
+}
+
+TEST_CASE("filtered_string copies share the buffer") {
+    auto str = fsv::filtered_string{fsv::filtered_string_view{"shared buffer", no_vowels}};
+    auto copy = str;
+    REQUIRE(copy.data() == str.data());
+    REQUIRE(copy == str);
+}
+
+TEST_CASE("filtered_string comparison and hashing") {
+    auto a = fsv::filtered_string{fsv::filtered_string_view{"apple", no_vowels}};
+    auto b = fsv::filtered_string{std::string{"ppl"}};
+    auto c = fsv::filtered_string{std::string{"pq"}};
+    REQUIRE(a == b);
+    REQUIRE(a < c);
+    REQUIRE((c <=> b) == std::strong_ordering::greater);
+    REQUIRE(a == fsv::filtered_string_view{"ppl"});
+    REQUIRE(fsv::filtered_string_view{"pq"} > a);
+
+    REQUIRE(fsv::hash{}(a) == fsv::hash{}(b));
+    REQUIRE(fsv::hash{}(a) == fsv::hash{}(fsv::filtered_string_view{"apple", no_vowels}));
+    REQUIRE(std::hash<fsv::filtered_string>{}(a) == fsv::hash{}(std::string{"ppl"}));
+
+    SECTION("default constructed") {
+        auto empty = fsv::filtered_string{};
+        REQUIRE(empty.empty());
+        REQUIRE(std::string{empty.data()}.empty());
+        REQUIRE(empty == fsv::filtered_string{std::string{}});
+        REQUIRE(fsv::hash{}(empty) == fsv::hash{}(fsv::filtered_string_view{""}));
+        REQUIRE(empty < a);
+    }
+
+    SECTION("as container keys") {
+        auto keys = std::unordered_set<fsv::filtered_string, fsv::hash, fsv::equal_to>{a, c};
+        REQUIRE(keys.size() == 2);
+        REQUIRE(keys.contains(b));
+        REQUIRE(keys.find(fsv::filtered_string_view{"p-q", [](const char& ch) { return ch != '-'; }}) != keys.end());
+
+        auto counts = std::map<fsv::filtered_string, int>{};
+        ++counts[a];
+        ++counts[b];
+        REQUIRE(counts.size() == 1);
+        REQUIRE(counts.begin()->second == 2);
+    }
+}
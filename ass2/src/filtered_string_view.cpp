@@ -1,12 +1,148 @@
 #include "./filtered_string_view.h"
+#include "./instrument.h"
+#include <algorithm>
+#include <bit>
 #include <compare>
 #include <cstring>
 #include <set>
+#include <string_view>
+#include <tuple>
 
 namespace fsv {
+    namespace {
+        constexpr std::size_t block_size = 64;
+
+        auto is_default(const filter& pred) noexcept -> bool {
+            return pred.target_type() == filtered_string_view::default_predicate.target_type();
+        }
+
+        // first character in [from, last) for which the filter returns `want`, or last
+        auto scan(const char* from, const char* last, const filter& pred, const char_class* cls, bool want)
+            -> const char* {
+            if (cls == nullptr) {
+                [[maybe_unused]] const char* start = from;
+                while (from != last && pred(*from) != want) {
+                    ++from;
+                }
+                FSV_INSTRUMENT_COUNT(predicate_calls, static_cast<std::size_t>(from - start) + (from != last ? 1 : 0));
+                return from;
+            }
+            while (from != last) {
+                const auto n = std::min(block_size, static_cast<std::size_t>(last - from));
+                auto mask = cls->match_mask(from, n);
+                if (!want) {
+                    mask = ~mask & (n == block_size ? ~std::uint64_t{0} : (std::uint64_t{1} << n) - 1);
+                }
+                if (mask != 0) {
+                    return from + std::countr_zero(mask);
+                }
+                from += n;
+            }
+            return last;
+        }
+
+        // Selects the characters accepted by `pred` whose address lies in [first, last). The views
+        // made by split and substr keep data() at the original string and use this as their filter.
+        // Over the default predicate the closure is two pointers, small enough to never allocate.
+        auto range_filter(const filter& pred, const char* first, const char* last) -> filter {
+            if (is_default(pred)) {
+                return [first, last](const char& c) { return first <= &c && &c < last; };
+            }
+            return [first, last, pred](const char& c) { return first <= &c && &c < last && instrument::call(pred, c); };
+        }
+
+        // KMP failure function: fail[i] is the length of the longest proper border of pat[0, i]
+        auto failure_table(const std::string& pat) -> std::vector<std::size_t> {
+            auto fail = std::vector<std::size_t>(pat.size(), 0);
+            std::size_t k = 0;
+            for (std::size_t i = 1; i < pat.size(); ++i) {
+                while (k > 0 && pat[i] != pat[k]) {
+                    k = fail[k - 1];
+                }
+                if (pat[i] == pat[k]) {
+                    ++k;
+                }
+                fail[i] = k;
+            }
+            return fail;
+        }
+    } // namespace
 
     filter filtered_string_view::default_predicate = [](const char&) { return true; };
 
+    auto char_class::match_mask(const char* first, std::size_t n) const noexcept -> std::uint64_t {
+        auto mask = std::uint64_t{0};
+        for (std::size_t i = 0; i < n; ++i) {
+            mask |= static_cast<std::uint64_t>(contains(first[i])) << i;
+        }
+        return mask;
+    }
+
+    filtered_string_view::iter::iter(const filtered_string_view& owner, const char* cur)
+    : first_(owner.ptr_)
+    , last_(owner.ptr_ + owner.length_)
+    , cur_(cur)
+    , pred_(is_default(owner.pred_) ? nullptr : &owner.pred_) {
+        if (const auto* cls = owner.pred_.target<char_class>()) {
+            class_ = *cls;
+            has_class_ = true;
+        }
+    }
+
+    // A char_class is tested a block at a time, and the block's remaining matches are kept so that
+    // the following increments just pop bits off the mask.
+    auto filtered_string_view::iter::next(const char* from) -> const char* {
+        if (!has_class_) {
+            return scan(from, last_, *pred_, nullptr, true);
+        }
+        while (from != last_) {
+            const auto n = std::min(block_size, static_cast<std::size_t>(last_ - from));
+            const auto mask = class_.match_mask(from, n);
+            if (mask != 0) {
+                block_ = from;
+                block_end_ = from + n;
+                mask_ = mask & (mask - 1);
+                return from + std::countr_zero(mask);
+            }
+            from += n;
+        }
+        block_end_ = nullptr;
+        mask_ = 0;
+        return last_;
+    }
+
+    auto filtered_string_view::iter::prev(const char* from) const -> const char* {
+        if (!has_class_) {
+            [[maybe_unused]] const char* start = from;
+            while (from != first_ && !(*pred_)(*(from - 1))) {
+                --from;
+            }
+            FSV_INSTRUMENT_COUNT(predicate_calls, static_cast<std::size_t>(start - from) + (from != first_ ? 1 : 0));
+            return from - 1;
+        }
+        while (from != first_) {
+            const auto n = std::min(block_size, static_cast<std::size_t>(from - first_));
+            from -= n;
+            const auto mask = class_.match_mask(from, n);
+            if (mask != 0) {
+                return from + (block_size - 1 - static_cast<std::size_t>(std::countl_zero(mask)));
+            }
+        }
+        return first_;
+    }
+
+    auto filtered_string_view::iter::operator++(int) -> iter {
+        auto old = *this;
+        ++*this;
+        return old;
+    }
+
+    auto filtered_string_view::iter::operator--(int) -> iter {
+        auto old = *this;
+        --*this;
+        return old;
+    }
+
     filtered_string_view::filtered_string_view() noexcept
     : ptr_(nullptr)
     , length_(0)
@@ -32,6 +168,11 @@ namespace fsv {
     , length_(std::strlen(str))
     , pred_(std::move(predicate)) {}
 
+    filtered_string_view::filtered_string_view(const char* str, std::size_t len, filter predicate)
+    : ptr_(str)
+    , length_(len)
+    , pred_(std::move(predicate)) {}
+
     filtered_string_view::filtered_string_view(const filtered_string_view& other)
     : ptr_(other.ptr_)
     , length_(other.length_)
@@ -68,53 +209,82 @@ namespace fsv {
     }
 
     auto filtered_string_view::operator[](std::size_t n) const -> const char& {
+        FSV_INSTRUMENT_COUNT(rescans, 1);
         std::size_t count = 0;
         for (std::size_t i = 0; i < length_; ++i) {
             if (pred_(ptr_[i])) {
                 if (count == n) {
+                    FSV_INSTRUMENT_COUNT(predicate_calls, i + 1);
                     return ptr_[i];
                 }
                 ++count;
             }
         }
+        FSV_INSTRUMENT_COUNT(predicate_calls, length_);
 
         return ptr_[0];
     }
 
-    filtered_string_view::operator std::string() const {
-        std::string result;
-        for (std::size_t i = 0; i < length_; ++i) {
-            if (pred_(ptr_[i])) {
-                result += ptr_[i];
+    template<typename F>
+    auto filtered_string_view::for_each_run(F&& visit) const -> void {
+        if (is_default(pred_)) {
+            if (length_ != 0) {
+                visit(ptr_, length_);
             }
+            return;
+        }
+        const char* last = ptr_ + length_;
+        const auto* cls = pred_.target<char_class>();
+        for (const char* p = scan(ptr_, last, pred_, cls, true); p != last;) {
+            const char* run_end = scan(p + 1, last, pred_, cls, false);
+            visit(p, static_cast<std::size_t>(run_end - p));
+            p = run_end == last ? last : scan(run_end + 1, last, pred_, cls, true);
+        }
+    }
+
+    auto filtered_string_view::next_run(const char* from) const -> std::pair<const char*, const char*> {
+        const char* last = ptr_ + length_;
+        if (is_default(pred_)) {
+            return {from, last};
         }
+        const auto* cls = pred_.target<char_class>();
+        const char* first = scan(from, last, pred_, cls, true);
+        return {first, first == last ? last : scan(first + 1, last, pred_, cls, false)};
+    }
+
+    filtered_string_view::operator std::string() const {
+        FSV_INSTRUMENT_COUNT(materializations, 1);
+        auto result = std::string{};
+        result.reserve(size());
+        FSV_INSTRUMENT_COUNT(rescans, 1);
+        for_each_run([&result](const char* first, std::size_t n) { result.append(first, n); });
         return result;
     }
 
     auto filtered_string_view::at(std::size_t index) const -> const char& {
+        FSV_INSTRUMENT_COUNT(rescans, 1);
         std::size_t count = 0;
         for (std::size_t i = 0; i < length_; ++i) {
             if (pred_(ptr_[i])) {
                 if (count == index) {
+                    FSV_INSTRUMENT_COUNT(predicate_calls, i + 1);
                     return ptr_[i];
                 }
                 ++count;
             }
         }
+        FSV_INSTRUMENT_COUNT(predicate_calls, length_);
 
         throw std::domain_error{"filtered_string_view::at(" + std::to_string(index) + "): invalid index"};
     }
 
-    auto filtered_string_view::size() const noexcept -> std::size_t {
+    auto filtered_string_view::size() const -> std::size_t {
+        FSV_INSTRUMENT_COUNT(rescans, 1);
         std::size_t count = 0;
-        for (std::size_t i = 0; i < length_; ++i) {
-            if (pred_(ptr_[i])) {
-                ++count;
-            }
-        }
+        for_each_run([&count](const char*, std::size_t n) { count += n; });
         return count;
     }
-    auto filtered_string_view::empty() const noexcept -> bool {
+    auto filtered_string_view::empty() const -> bool {
         return size() == 0;
     }
     auto filtered_string_view::data() const noexcept -> const char* {
@@ -123,71 +293,212 @@ namespace fsv {
     auto filtered_string_view::predicate() const noexcept -> const filter& {
         return pred_;
     }
-    auto operator==(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs) -> bool {
-        std::size_t lhs_size = lhs.size();
-        std::size_t rhs_size = rhs.size();
-        if (lhs_size != rhs_size) {
+
+    // With the default predicate, filtered and raw indices coincide, so candidates are found with
+    // memchr on the first character and confirmed with memcmp. Otherwise the filtered text is
+    // streamed once through the iterator with KMP, which needs no random access into it.
+    template<typename F>
+    auto filtered_string_view::for_each_match(const std::string& pat,
+                                              std::size_t from,
+                                              bool overlapping,
+                                              F&& on_match) const -> void {
+        const auto m = pat.size();
+        if (is_default(pred_)) {
+            if (m > length_ || from > length_ - m) {
+                return;
+            }
+            const char* last = ptr_ + (length_ - m + 1);
+            for (const char* p = ptr_ + from; p < last;) {
+                const auto* hit =
+                    static_cast<const char*>(std::memchr(p, pat.front(), static_cast<std::size_t>(last - p)));
+                if (hit == nullptr) {
+                    return;
+                }
+                if (std::memcmp(hit + 1, pat.data() + 1, m - 1) != 0) {
+                    p = hit + 1;
+                    continue;
+                }
+                if (!on_match(static_cast<std::size_t>(hit - ptr_))) {
+                    return;
+                }
+                p = hit + (overlapping ? 1 : m);
+            }
+            return;
+        }
+
+        const auto fail = failure_table(pat);
+        std::size_t matched = 0;
+        std::size_t i = 0;
+        for (auto it = begin(), last = end(); it != last; ++it, ++i) {
+            while (matched > 0 && *it != pat[matched]) {
+                matched = fail[matched - 1];
+            }
+            if (*it == pat[matched]) {
+                ++matched;
+            }
+            if (matched == m) {
+                if (i + 1 - m >= from && !on_match(i + 1 - m)) {
+                    return;
+                }
+                matched = overlapping ? fail[m - 1] : 0;
+            }
+        }
+    }
+
+    auto filtered_string_view::find(const filtered_string_view& pattern, std::size_t pos) const -> std::size_t {
+        const auto pat = static_cast<std::string>(pattern);
+        if (pat.empty()) {
+            return pos <= size() ? pos : npos;
+        }
+        auto result = npos;
+        for_each_match(pat, pos, true, [&result](std::size_t i) {
+            result = i;
             return false;
+        });
+        return result;
+    }
+
+    auto filtered_string_view::rfind(const filtered_string_view& pattern, std::size_t pos) const -> std::size_t {
+        const auto pat = static_cast<std::string>(pattern);
+        if (pat.empty()) {
+            return std::min(pos, size());
         }
-        for (std::size_t i = 0; i < lhs_size; ++i) {
-            if (lhs[i] != rhs[i]) {
+        auto result = npos;
+        for_each_match(pat, 0, true, [&result, pos](std::size_t i) {
+            if (i > pos) {
                 return false;
             }
+            result = i;
+            return true;
+        });
+        return result;
+    }
+
+    auto filtered_string_view::contains(const filtered_string_view& pattern) const -> bool {
+        return find(pattern) != npos;
+    }
+
+    auto filtered_string_view::count(const filtered_string_view& pattern) const -> std::size_t {
+        const auto pat = static_cast<std::string>(pattern);
+        if (pat.empty()) {
+            return 0;
         }
-        return true;
+        std::size_t n = 0;
+        for_each_match(pat, 0, false, [&n](std::size_t) {
+            ++n;
+            return true;
+        });
+        return n;
     }
-    auto operator!=(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs) -> bool {
-        return !(lhs == rhs);
+
+    auto filtered_string_view::begin() const -> const_iterator {
+        auto it = iter{*this, ptr_};
+        if (it.pred_ != nullptr) {
+            it.cur_ = it.next(ptr_);
+        }
+        return it;
+    }
+    auto filtered_string_view::end() const -> const_iterator {
+        return iter{*this, ptr_ + length_};
+    }
+    auto filtered_string_view::cbegin() const -> const_iterator {
+        return begin();
+    }
+    auto filtered_string_view::cend() const -> const_iterator {
+        return end();
+    }
+    auto filtered_string_view::rbegin() const -> const_reverse_iterator {
+        return const_reverse_iterator{end()};
+    }
+    auto filtered_string_view::rend() const -> const_reverse_iterator {
+        return const_reverse_iterator{begin()};
+    }
+    auto filtered_string_view::crbegin() const -> const_reverse_iterator {
+        return rbegin();
+    }
+    auto filtered_string_view::crend() const -> const_reverse_iterator {
+        return rend();
+    }
+    // Characters compare as unsigned char, like std::string. When neither side filters anything
+    // the raw ranges are compared with memcmp; otherwise both views are walked once in lockstep.
+    auto operator==(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs) -> bool {
+        if (is_default(lhs.pred_) && is_default(rhs.pred_)) {
+            return lhs.length_ == rhs.length_
+                   && (lhs.length_ == 0 || std::memcmp(lhs.ptr_, rhs.ptr_, lhs.length_) == 0);
+        }
+        return std::is_eq(lhs <=> rhs);
     }
 
-    auto operator<(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs) -> bool {
-        std::size_t i = 0;
-        std::size_t lhs_size = lhs.size();
-        std::size_t rhs_size = rhs.size();
-        while (i < lhs_size && i < rhs_size) {
-            if (lhs[i] != rhs[i]) {
-                return lhs[i] < rhs[i];
+    auto operator<=>(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs)
+        -> std::strong_ordering {
+        if (is_default(lhs.pred_) && is_default(rhs.pred_)) {
+            const auto n = std::min(lhs.length_, rhs.length_);
+            const auto cmp = n == 0 ? 0 : std::memcmp(lhs.ptr_, rhs.ptr_, n);
+            if (cmp != 0) {
+                return cmp <=> 0;
+            }
+            return lhs.length_ <=> rhs.length_;
+        }
+
+        auto l = lhs.begin();
+        auto r = rhs.begin();
+        const auto l_end = lhs.end();
+        const auto r_end = rhs.end();
+        for (; l != l_end && r != r_end; ++l, ++r) {
+            if (*l != *r) {
+                return static_cast<unsigned char>(*l) <=> static_cast<unsigned char>(*r);
             }
-            ++i;
         }
-        return lhs_size < rhs_size;
+        if (l != l_end) {
+            return std::strong_ordering::greater;
+        }
+        if (r != r_end) {
+            return std::strong_ordering::less;
+        }
+        return std::strong_ordering::equal;
     }
-    auto operator>(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs) -> bool {
-        return rhs < lhs;
+
+    auto hash::fnv1a(std::uint64_t h, const char* first, std::size_t n) noexcept -> std::uint64_t {
+        constexpr auto fnv_prime = std::uint64_t{1099511628211U};
+        for (const char* p = first; p != first + n; ++p) {
+            h = (h ^ static_cast<unsigned char>(*p)) * fnv_prime;
+        }
+        return h;
     }
-    auto operator<=(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs) -> bool {
-        return !(rhs < lhs);
+
+    auto hash::operator()(const filtered_string_view& fsv) const -> std::size_t {
+        auto h = fnv_offset_basis;
+        fsv.for_each_run([&h](const char* first, std::size_t n) { h = fnv1a(h, first, n); });
+        return static_cast<std::size_t>(h);
     }
-    auto operator>=(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs) -> bool {
-        return !(lhs < rhs);
+
+    auto equal_to::operator()(const filtered_string_view& lhs, const filtered_string_view& rhs) const -> bool {
+        return lhs == rhs;
     }
+
     auto operator<<(std::ostream& os, const fsv::filtered_string_view& fsv) -> std::ostream& {
-        for (std::size_t i = 0; i < fsv.size(); ++i) {
-            os << fsv[i];
-        }
+        fsv.for_each_run(
+            [&os](const char* first, std::size_t n) { os.write(first, static_cast<std::streamsize>(n)); });
         return os;
     }
 
     auto compose(const filtered_string_view& fsv, const std::vector<filter>& filts) -> filtered_string_view {
         filter composed_pred = [filts](const char& c) {
             for (const auto& f : filts) {
-                if (!f(c)) {
+                if (!instrument::call(f, c)) {
                     return false;
                 }
             }
             return true;
         };
-        return filtered_string_view{fsv.data(), composed_pred};
+        return filtered_string_view{fsv.ptr_, fsv.length_, composed_pred};
     }
 
     auto split(const filtered_string_view& fsv, const filtered_string_view& tok) -> std::vector<filtered_string_view> {
         std::vector<filtered_string_view> result;
         const char* base = fsv.data();
         const auto& pred = fsv.predicate();
-        std::string full_str;
-        for (std::size_t i = 0; i < fsv.size(); ++i) {
-            full_str += fsv[i];
-        }
+        std::string full_str = static_cast<std::string>(fsv);
         std::string tok_str = static_cast<std::string>(tok);
 
         // if token is empty (after filtering), treat it as not appearing in fsv
@@ -196,35 +507,126 @@ namespace fsv {
             return result;
         }
 
+        // a single pass over fsv: `it` is the filtered character at index `index`
+        auto it = fsv.begin();
+        std::size_t index = 0;
         std::size_t start = 0;
         // iterate through all token occurrences
         while (true) {
             std::size_t pos = full_str.find(tok_str, start);
             std::size_t end = (pos == std::string::npos) ? full_str.size() : pos;
-            std::size_t filtered_offset = 0;
-            std::vector<const char*> selected_chars;
-            for (std::size_t i = 0; i < strlen(base); ++i) {
-                if (pred(base[i])) {
-                    if (filtered_offset >= start && filtered_offset < end) {
-                        selected_chars.push_back(&base[i]);
-                    }
-                    ++filtered_offset;
-                }
+            for (; index < start; ++index) {
+                ++it;
             }
-            filter sub_pred = [selected_chars](const char& c) {
-                for (auto ptr : selected_chars) {
-                    if (&c == ptr)
-                        return true;
-                }
-                return false;
-            };
-            result.emplace_back(base, sub_pred);
+            const char* first = nullptr;
+            const char* last = nullptr;
+            for (; index < end; ++index, ++it) {
+                first = first == nullptr ? &*it : first;
+                last = &*it + 1;
+            }
+            result.emplace_back(base, static_cast<std::size_t>(last == nullptr ? 0 : last - base),
+                                range_filter(pred, first, last));
             if (pos == std::string::npos)
                 break;
             start = pos + tok_str.size();
         }
         return result;
     }
+    split_view::split_view(const filtered_string_view& fsv, const filtered_string_view& tok)
+    : base_(fsv)
+    , tok_(static_cast<std::string>(tok))
+    , pred_(is_default(fsv.pred_) ? nullptr : std::make_shared<const filter>(fsv.pred_)) {}
+
+    auto split_view::begin() const -> iterator {
+        return iter{this, base_.ptr_};
+    }
+
+    auto split_view::end() const -> iterator {
+        auto it = iter{};
+        it.parent_ = this;
+        it.cur_ = base_.ptr_ + base_.length_;
+        it.delim_ = it.cur_;
+        it.next_ = it.cur_;
+        return it;
+    }
+
+    // returns the raw extent [first, last) of the leftmost delimiter at or after `from`,
+    // or an empty range at the end of the view if there is none
+    auto split_view::find_delim(const char* from) const -> std::pair<const char*, const char*> {
+        const char* last = base_.ptr_ + base_.length_;
+        if (tok_.empty()) {
+            return {last, last};
+        }
+        if (pred_ == nullptr) {
+            const auto haystack = std::string_view{from, static_cast<std::size_t>(last - from)};
+            const auto pos = haystack.find(tok_);
+            return pos == std::string_view::npos ? std::pair{last, last}
+                                                 : std::pair{from + pos, from + pos + tok_.size()};
+        }
+        // candidates start with the token's first character, so skip to those with memchr
+        const auto& pred = *pred_;
+        for (const char* p = from; p != last; ++p) {
+            p = static_cast<const char*>(std::memchr(p, tok_.front(), static_cast<std::size_t>(last - p)));
+            if (p == nullptr) {
+                break;
+            }
+            if (!instrument::call(pred, *p)) {
+                continue;
+            }
+            std::size_t matched = 0;
+            const char* q = p;
+            for (; q != last && matched < tok_.size(); ++q) {
+                if (!instrument::call(pred, *q)) {
+                    continue;
+                }
+                if (*q != tok_[matched]) {
+                    break;
+                }
+                ++matched;
+            }
+            if (matched == tok_.size()) {
+                return {p, q};
+            }
+        }
+        return {last, last};
+    }
+
+    split_view::iter::iter(const split_view* parent, const char* cur)
+    : parent_(parent)
+    , cur_(cur)
+    , done_(false) {
+        std::tie(delim_, next_) = parent_->find_delim(cur_);
+    }
+
+    // the slice's filter is a single pointer, which std::function stores without allocating
+    auto split_view::iter::operator*() const -> filtered_string_view {
+        const auto len = static_cast<std::size_t>(delim_ - cur_);
+        if (parent_->pred_ == nullptr) {
+            return filtered_string_view{cur_, len, filtered_string_view::default_predicate};
+        }
+        return filtered_string_view{cur_, len, [pred = parent_->pred_.get()](const char& c) {
+                                        return instrument::call(*pred, c);
+                                    }};
+    }
+
+    auto split_view::iter::operator++() -> iter& {
+        if (delim_ == next_) {
+            // that was the last slice
+            cur_ = next_;
+            done_ = true;
+        }
+        else {
+            *this = iter{parent_, next_};
+        }
+        return *this;
+    }
+
+    auto split_view::iter::operator++(int) -> iter {
+        auto old = *this;
+        ++*this;
+        return old;
+    }
+
     auto substr(const filtered_string_view& fsv, std::size_t pos, std::optional<std::size_t> count)
         -> filtered_string_view {
         std::size_t fsv_size = fsv.size();
@@ -233,26 +635,21 @@ namespace fsv {
                                     + "): position out of range for filtered string of size " + std::to_string(fsv_size)};
         }
         std::size_t end = count ? std::min(pos + count.value(), fsv_size) : fsv_size;
-        std::vector<const char*> selected_chars;
+        const char* first = nullptr;
+        const char* last = nullptr;
         std::size_t filtered_index = 0;
-        const char* base = fsv.data();
-        const auto& pred = fsv.predicate();
-        for (std::size_t i = 0; i < std::strlen(base); ++i) {
-            if (pred(base[i])) {
-                if (filtered_index >= pos && filtered_index < end) {
-                    selected_chars.push_back(&base[i]);
-                }
-                ++filtered_index;
+        for (auto it = fsv.begin(); filtered_index < end; ++it, ++filtered_index) {
+            if (filtered_index == pos) {
+                first = &*it;
             }
+            last = &*it + 1;
         }
-        filter sub_pred = [selected_chars](const char& c) {
-            for (auto ptr : selected_chars) {
-                if (&c == ptr) {
-                    return true;
-                }
-            }
-            return false;
-        };
-        return filtered_string_view{base, sub_pred};
+        if (first == nullptr) {
+            last = nullptr;
+        }
+        const char* base = fsv.data();
+        return filtered_string_view{base,
+                                    static_cast<std::size_t>(last == nullptr ? 0 : last - base),
+                                    range_filter(fsv.predicate(), first, last)};
     }
 } // namespace fsv
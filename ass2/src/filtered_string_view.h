@@ -1,38 +1,147 @@
 #ifndef COMP6771_ASS2_FSV_H
 #define COMP6771_ASS2_FSV_H
 
+#include <array>
+#include <bit>
 #include <compare>
+#include <concepts>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <ostream>
+#include <ranges>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace fsv {
     using filter = std::function<bool(const char&)>;
 
+    class split_view;
+    class tokenizer;
+    class filtered_string;
+    class transformed_filtered_view;
+
+    // A set of characters, usable as a `filter`. Iterating a view filtered by a char_class
+    // tests 64 characters at a time and jumps straight to the next match.
+    class char_class {
+    public:
+        constexpr char_class() noexcept = default;
+        constexpr explicit char_class(const char* chars) noexcept {
+            for (; *chars != '\0'; ++chars) {
+                insert(*chars);
+            }
+        }
+
+        constexpr auto insert(char c) noexcept -> void {
+            const auto u = static_cast<unsigned char>(c);
+            bits_[u >> 6U] |= std::uint64_t{1} << (u & 63U);
+        }
+        [[nodiscard]] constexpr auto contains(char c) const noexcept -> bool {
+            const auto u = static_cast<unsigned char>(c);
+            return ((bits_[u >> 6U] >> (u & 63U)) & 1U) != 0;
+        }
+        constexpr auto operator()(const char& c) const noexcept -> bool {
+            return contains(c);
+        }
+
+        // combining classes yields another class, which keeps the block scanning fast path
+        friend constexpr auto operator&&(const char_class& lhs, const char_class& rhs) noexcept -> char_class {
+            auto result = char_class{};
+            for (std::size_t i = 0; i < result.bits_.size(); ++i) {
+                result.bits_[i] = lhs.bits_[i] & rhs.bits_[i];
+            }
+            return result;
+        }
+        friend constexpr auto operator||(const char_class& lhs, const char_class& rhs) noexcept -> char_class {
+            auto result = char_class{};
+            for (std::size_t i = 0; i < result.bits_.size(); ++i) {
+                result.bits_[i] = lhs.bits_[i] | rhs.bits_[i];
+            }
+            return result;
+        }
+        friend constexpr auto operator!(const char_class& cls) noexcept -> char_class {
+            auto result = char_class{};
+            for (std::size_t i = 0; i < result.bits_.size(); ++i) {
+                result.bits_[i] = ~cls.bits_[i];
+            }
+            return result;
+        }
+
+        // bit i of the result is set if first[i] is in the class, for i < n <= 64
+        [[nodiscard]] auto match_mask(const char* first, std::size_t n) const noexcept -> std::uint64_t;
+
+    private:
+        std::array<std::uint64_t, 4> bits_{};
+    };
+
     class filtered_string_view {
         class iter {
         public:
-            using MEMBER_TYPEDEFS_GO_HERE = void;
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = char;
+            using reference = const char&;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
 
-            iter();
+            iter() = default;
 
-            auto operator*() const -> void; // change this
-            auto operator->() const -> void; // change this
+            auto operator*() const -> reference {
+                return *cur_;
+            }
 
-            auto operator++() -> iter&;
+            auto operator++() -> iter& {
+                if (pred_ == nullptr) {
+                    ++cur_;
+                }
+                else if (mask_ != 0) {
+                    cur_ = block_ + std::countr_zero(mask_);
+                    mask_ &= mask_ - 1;
+                }
+                else {
+                    cur_ = next(block_end_ != nullptr ? block_end_ : cur_ + 1);
+                }
+                return *this;
+            }
             auto operator++(int) -> iter;
-            auto operator--() -> iter&;
+            auto operator--() -> iter& {
+                cur_ = pred_ == nullptr ? cur_ - 1 : prev(cur_);
+                block_end_ = nullptr;
+                mask_ = 0;
+                return *this;
+            }
             auto operator--(int) -> iter;
 
-            friend auto operator==(const iter&, const iter&) -> bool;
-            friend auto operator!=(const iter&, const iter&) -> bool;
+            friend auto operator==(const iter& lhs, const iter& rhs) -> bool {
+                return lhs.cur_ == rhs.cur_;
+            }
 
         private:
-            /* Implementation-specific helper functions*/
+            iter(const filtered_string_view& owner, const char* cur);
+
+            // first passing character in [from, last_), or last_; for a char_class this also caches the
+            // rest of the block it was found in
+            auto next(const char* from) -> const char*;
+            // last passing character in [first_, from)
+            auto prev(const char* from) const -> const char*;
+
+            const char* first_ = nullptr;
+            const char* last_ = nullptr;
+            const char* cur_ = nullptr;
+            // null when every character passes, otherwise the view's predicate
+            const filter* pred_ = nullptr;
+            // a copy of the predicate when it is a char_class, which is scanned a block at a time
+            char_class class_;
+            bool has_class_ = false;
+            // char_class only: the passing characters of [block_, block_end_) after cur_, as bits
+            // relative to block_; block_end_ is null when nothing is cached
+            const char* block_ = nullptr;
+            const char* block_end_ = nullptr;
+            std::uint64_t mask_ = 0;
 
-            /* Implementation-specific private members */
+            friend class filtered_string_view;
         };
 
     public:
@@ -41,6 +150,7 @@ namespace fsv {
         filtered_string_view(const std::string& str, filter predicate);
         filtered_string_view(const char* str);
         filtered_string_view(const char* str, filter predicate);
+        filtered_string_view(const char* str, std::size_t len, filter predicate);
         filtered_string_view(const filtered_string_view& other);
         filtered_string_view(filtered_string_view&& other);
         ~filtered_string_view() = default;
@@ -51,37 +161,179 @@ namespace fsv {
         auto at(std::size_t index) const -> const char&;
         explicit operator std::string() const;
 
-        [[nodiscard]] auto size() const noexcept -> std::size_t;
-        [[nodiscard]] auto empty() const noexcept -> bool;
+        [[nodiscard]] auto size() const -> std::size_t;
+        [[nodiscard]] auto empty() const -> bool;
         [[nodiscard]] auto data() const noexcept -> const char*;
         [[nodiscard]] auto predicate() const noexcept -> const filter&;
 
+        // Searches the filtered text. Positions are filtered indices; an empty pattern matches
+        // like std::string::find does, except that count() treats it as not appearing (as split does).
+        [[nodiscard]] auto find(const filtered_string_view& pattern, std::size_t pos = 0) const -> std::size_t;
+        [[nodiscard]] auto rfind(const filtered_string_view& pattern, std::size_t pos = npos) const -> std::size_t;
+        [[nodiscard]] auto contains(const filtered_string_view& pattern) const -> bool;
+        // number of non-overlapping occurrences
+        [[nodiscard]] auto count(const filtered_string_view& pattern) const -> std::size_t;
+
+        // Bulk access to the passing characters: the first maximal run [first, last) of them at or
+        // after the raw position `from` (between data() and the end of the viewed text), or an
+        // empty run at the end. Start from data() and continue from each run's `last`.
+        [[nodiscard]] auto next_run(const char* from) const -> std::pair<const char*, const char*>;
+
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
         static filter default_predicate;
 
-        using iterator = void; // change this
-        using const_iterator = void; // change this
-        using reverse_iterator = void; // change this
-        using const_reverse_iterator = void; // change this
+        using iterator = iter;
+        using const_iterator = iter;
+        using reverse_iterator = std::reverse_iterator<iter>;
+        using const_reverse_iterator = std::reverse_iterator<iter>;
+
+        // Like std::ranges::filter_view's, iterators refer to the view's predicate and are invalidated
+        // when the view is destroyed, moved from or assigned to. Iterators over the default
+        // predicate or a char_class carry everything they need and only depend on the viewed text.
+        [[nodiscard]] auto begin() const -> const_iterator;
+        [[nodiscard]] auto end() const -> const_iterator;
+        [[nodiscard]] auto cbegin() const -> const_iterator;
+        [[nodiscard]] auto cend() const -> const_iterator;
+        [[nodiscard]] auto rbegin() const -> const_reverse_iterator;
+        [[nodiscard]] auto rend() const -> const_reverse_iterator;
+        [[nodiscard]] auto crbegin() const -> const_reverse_iterator;
+        [[nodiscard]] auto crend() const -> const_reverse_iterator;
 
     private:
         /* Implementation-specific helper functions*/
+        // calls visit(first, count) on each maximal run of consecutive passing characters, in order
+        template<typename F>
+        auto for_each_run(F&& visit) const -> void;
+        // calls on_match(i) on each match of `pat` (non-empty) starting at filtered index i >= from,
+        // left to right, until it returns false
+        template<typename F>
+        auto for_each_match(const std::string& pat, std::size_t from, bool overlapping, F&& on_match) const -> void;
+
         const char* ptr_;
         std::size_t length_;
         filter pred_;
 
         /* Implementation-specific private members */
+        friend class split_view;
+        friend class tokenizer;
+        friend class transformed_filtered_view;
+        friend auto operator==(const filtered_string_view& lhs, const filtered_string_view& rhs) -> bool;
+        friend auto operator<=>(const filtered_string_view& lhs, const filtered_string_view& rhs)
+            -> std::strong_ordering;
+        friend auto operator<<(std::ostream& os, const filtered_string_view& fsv) -> std::ostream&;
+        friend struct hash;
+        friend auto compose(const filtered_string_view& fsv, const std::vector<filter>& filts) -> filtered_string_view;
+        template<typename Pred>
+            requires std::predicate<const Pred&, const char&>
+        friend auto compose(const filtered_string_view& fsv, Pred pred) -> filtered_string_view;
+    };
+
+    // Transparent hash and equality over the filtered text, so that containers keyed by std::string
+    // can be probed with a filtered_string_view without materialising it:
+    //     std::unordered_set<std::string, fsv::hash, fsv::equal_to>
+    // The hash is FNV-1a over the filtered characters, computed run by run, so a view and a
+    // std::string holding the same text hash equally.
+    struct hash {
+        using is_transparent = void;
+        auto operator()(const filtered_string_view& fsv) const -> std::size_t;
+        // cached when the string was built, see filtered_string.h
+        auto operator()(const filtered_string& str) const noexcept -> std::size_t;
+        // over the mapped characters, see transformed_filtered_view.h
+        auto operator()(const transformed_filtered_view& view) const -> std::size_t;
+
+    private:
+        // FNV-1a, continued from `h` over [first, first + n); the views feed it one run at a time
+        static constexpr auto fnv_offset_basis = std::uint64_t{14695981039346656037U};
+        static auto fnv1a(std::uint64_t h, const char* first, std::size_t n) noexcept -> std::uint64_t;
     };
+
+    struct equal_to {
+        using is_transparent = void;
+        auto operator()(const filtered_string_view& lhs, const filtered_string_view& rhs) const -> bool;
+        auto operator()(const transformed_filtered_view& lhs, const filtered_string_view& rhs) const -> bool;
+        auto operator()(const filtered_string_view& lhs, const transformed_filtered_view& rhs) const -> bool;
+    };
+
+    // Lazily splits `fsv` on the filtered text of `tok`, with the same semantics as `split`.
+    // Each slice views the raw range between two delimiters with `fsv`'s predicate, so iterating
+    // finds one delimiter at a time and never materialises the haystack. Slices refer to the
+    // predicate shared by the split_view and its copies instead of copying it, so they must not
+    // outlive all of them (unless `fsv` uses the default predicate).
+    class split_view : public std::ranges::view_interface<split_view> {
+        class iter {
+        public:
+            using iterator_concept = std::forward_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = filtered_string_view;
+            using difference_type = std::ptrdiff_t;
+            using reference = filtered_string_view;
+            using pointer = void;
+
+            iter() = default;
+
+            auto operator*() const -> filtered_string_view;
+
+            auto operator++() -> iter&;
+            auto operator++(int) -> iter;
+
+            friend auto operator==(const iter& lhs, const iter& rhs) -> bool {
+                return lhs.cur_ == rhs.cur_ && lhs.done_ == rhs.done_;
+            }
+
+        private:
+            iter(const split_view* parent, const char* cur);
+
+            const split_view* parent_ = nullptr;
+            const char* cur_ = nullptr; // start of the current slice
+            const char* delim_ = nullptr; // start of the delimiter ending the slice
+            const char* next_ = nullptr; // one past that delimiter; equal to delim_ if there is none
+            bool done_ = true;
+
+            friend class split_view;
+        };
+
+    public:
+        using iterator = iter;
+        using const_iterator = iter;
+
+        split_view() = default;
+        split_view(const filtered_string_view& fsv, const filtered_string_view& tok);
+
+        [[nodiscard]] auto begin() const -> iterator;
+        [[nodiscard]] auto end() const -> iterator;
+
+    private:
+        auto find_delim(const char* from) const -> std::pair<const char*, const char*>;
+
+        filtered_string_view base_;
+        std::string tok_;
+        // base_'s predicate, held once so that every slice can point at it; null if it's the default
+        std::shared_ptr<const filter> pred_;
+    };
+
     auto operator==(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs) -> bool;
-    auto operator!=(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs) -> bool;
-    auto operator<(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs) -> bool;
-    auto operator>(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs) -> bool;
-    auto operator<=(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs) -> bool;
-    auto operator>=(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs) -> bool;
+    auto operator<=>(const fsv::filtered_string_view& lhs, const fsv::filtered_string_view& rhs)
+        -> std::strong_ordering;
     auto operator<<(std::ostream& os, const fsv::filtered_string_view& fsv) -> std::ostream&;
     auto compose(const filtered_string_view& fsv, const std::vector<filter>& filts) -> filtered_string_view;
+    // Replaces the predicate of `fsv` with the single callable `pred`. Given a fused predicate
+    // expression (see filter_expr.h), this composes filters with one indirect call per character.
+    template<typename Pred>
+        requires std::predicate<const Pred&, const char&>
+    auto compose(const filtered_string_view& fsv, Pred pred) -> filtered_string_view {
+        return filtered_string_view{fsv.ptr_, fsv.length_, std::move(pred)};
+    }
     auto split(const filtered_string_view& fsv, const filtered_string_view& tok) -> std::vector<filtered_string_view>;
     auto substr(const filtered_string_view& fsv, std::size_t pos = 0, std::optional<std::size_t> count = std::nullopt)
         -> filtered_string_view;
 } // namespace fsv
 
+template<>
+struct std::hash<fsv::filtered_string_view> {
+    auto operator()(const fsv::filtered_string_view& fsv) const -> std::size_t {
+        return fsv::hash{}(fsv);
+    }
+};
+
 #endif // COMP6771_ASS2_FSV_H
@@ -1,8 +1,13 @@
 #include "./filtered_string_view.h"
 #include <catch2/catch.hpp>
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <iterator>
 #include <set>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 // TEST_CASE("filter me if you can") {
 //     REQUIRE(false);
@@ -333,6 +338,20 @@ TEST_CASE("split") {
         REQUIRE(static_cast<std::string>(v[1]) == "");
         REQUIRE(static_cast<std::string>(v[2]) == "");
     }
+
+    SECTION("pieces of a filtered view") {
+        const auto text = std::string{"k1=v1; k2=v2;;k3"};
+        auto no_digits = fsv::filtered_string_view{text.data(), [](const char& c) { return c < '0' || c > '9'; }};
+        auto v = fsv::split(no_digits, fsv::filtered_string_view{";"});
+        REQUIRE(v.size() == 4);
+        REQUIRE(static_cast<std::string>(v[0]) == "k=v");
+        REQUIRE(static_cast<std::string>(v[1]) == " k=v");
+        REQUIRE(v[2].empty());
+        REQUIRE(static_cast<std::string>(v[3]) == "k");
+        for (const auto& piece : v) {
+            REQUIRE(piece.data() == text.data());
+        }
+    }
 }
 // 2.8.3
 TEST_CASE("substr") {
@@ -359,4 +378,302 @@ TEST_CASE("substr") {
         REQUIRE(sub1.empty());
         REQUIRE(sub2.empty());
     }
-}
\ No newline at end of file
+
+    SECTION("pieces keep the source predicate and data") {
+        const auto text = std::string{"a-b-c--d-e"};
+        auto letters = fsv::filtered_string_view{text.data(), [](const char& c) { return c != '-'; }};
+        auto sub = fsv::substr(letters, 1, 3);
+        REQUIRE(static_cast<std::string>(sub) == "bcd");
+        REQUIRE(sub.data() == text.data());
+        auto copy = sub;
+        REQUIRE(static_cast<std::string>(fsv::substr(copy, 1)) == "cd");
+    }
+}
+TEST_CASE("split_view") {
+    static_assert(std::ranges::forward_range<fsv::split_view>);
+    static_assert(std::ranges::view<fsv::split_view>);
+
+    SECTION("agrees with split") {
+        auto wentworth = fsv::filtered_string_view{"Malcom? Bligh? Turnbull", [](const char& c) { return c != '?'; }};
+        auto token = fsv::filtered_string_view{" 2015", [](const char& c) { return c == ' '; }};
+        auto lazy = fsv::split_view{wentworth, token};
+        auto eager = fsv::split(wentworth, token);
+        REQUIRE(std::ranges::distance(lazy) == 3);
+        REQUIRE(std::ranges::equal(lazy, eager));
+        REQUIRE(static_cast<std::string>(*std::next(lazy.begin())) == "Bligh");
+    }
+
+    SECTION("empty slices at the edges") {
+        auto sv = fsv::filtered_string_view{"xx"};
+        auto tok = fsv::filtered_string_view{"x"};
+        auto v = std::vector<std::string>{};
+        for (const auto& slice : fsv::split_view{sv, tok}) {
+            v.push_back(static_cast<std::string>(slice));
+        }
+        REQUIRE(v == std::vector<std::string>{"", "", ""});
+    }
+
+    SECTION("delimiter interrupted by filtered out characters") {
+        auto sv = fsv::filtered_string_view{"a-b,_-c", [](const char& c) { return c != '_'; }};
+        auto tok = fsv::filtered_string_view{",-"};
+        auto v = std::vector<std::string>{};
+        for (const auto& slice : fsv::split_view{sv, tok}) {
+            v.push_back(static_cast<std::string>(slice));
+        }
+        REQUIRE(v == std::vector<std::string>{"a-b", "c"});
+    }
+
+    SECTION("slices share the predicate instead of copying it") {
+        struct counted_not_space {
+            int* copies;
+            std::array<char, 64> padding{}; // too big for std::function's small buffer
+            counted_not_space(int* c)
+            : copies(c) {}
+            counted_not_space(const counted_not_space& other)
+            : copies(other.copies) {
+                ++*copies;
+            }
+            auto operator()(const char& c) const -> bool {
+                return c != ' ';
+            }
+        };
+        auto copies = 0;
+        auto sv = fsv::filtered_string_view{"a b,c d,e f,g h", counted_not_space{&copies}};
+        auto lazy = fsv::split_view{sv, ","};
+        const auto before = copies;
+        auto v = std::vector<std::string>{};
+        for (const auto& slice : lazy) {
+            v.push_back(static_cast<std::string>(slice));
+        }
+        REQUIRE(v == std::vector<std::string>{"ab", "cd", "ef", "gh"});
+        REQUIRE(copies == before);
+    }
+
+    SECTION("empty token or empty view yields the whole view") {
+        auto sv = fsv::filtered_string_view{"fishing"};
+        auto lazy = fsv::split_view{sv, ""};
+        REQUIRE(std::ranges::distance(lazy) == 1);
+        REQUIRE(lazy.front() == sv);
+
+        auto nothing = fsv::split_view{fsv::filtered_string_view{}, "x"};
+        REQUIRE(std::ranges::distance(nothing) == 1);
+        REQUIRE(nothing.front().empty());
+    }
+}
+
+// 2.9
+TEST_CASE("iterator") {
+    static_assert(std::bidirectional_iterator<fsv::filtered_string_view::iterator>);
+    static_assert(std::ranges::bidirectional_range<fsv::filtered_string_view>);
+
+    SECTION("default predicate") {
+        auto sv = fsv::filtered_string_view{"ned"};
+        auto it = sv.begin();
+        REQUIRE(*it == 'n');
+        REQUIRE(*++it == 'e');
+        REQUIRE(*++it == 'd');
+        REQUIRE(++it == sv.end());
+    }
+
+    SECTION("skips filtered out characters") {
+        auto sv = fsv::filtered_string_view{"samoyed", [](const char& c) {
+                                                return !(c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u');
+                                            }};
+        auto it = sv.begin();
+        REQUIRE(*it == 's');
+        REQUIRE(*std::next(it) == 'm');
+        REQUIRE(*std::next(it, 2) == 'y');
+        REQUIRE(*std::next(it, 3) == 'd');
+        REQUIRE(std::next(it, 4) == sv.end());
+    }
+
+    SECTION("backwards from the end") {
+        const auto str = std::string("tosa");
+        const auto s = fsv::filtered_string_view{str};
+        auto it = s.cend();
+        REQUIRE(*std::prev(it) == 'a');
+        REQUIRE(*std::prev(it, 2) == 's');
+    }
+
+    SECTION("ranges") {
+        const auto s = fsv::filtered_string_view{"puppy", [](const char& c) { return !(c == 'u' || c == 'y'); }};
+        REQUIRE(std::vector<char>{s.begin(), s.end()} == std::vector<char>{'p', 'p', 'p'});
+
+        auto m = fsv::filtered_string_view{"milo", [](const char& c) { return !(c == 'i' || c == 'o'); }};
+        REQUIRE(std::vector<char>{m.rbegin(), m.rend()} == std::vector<char>{'l', 'm'});
+        REQUIRE(std::ranges::count(m, 'm') == 1);
+    }
+
+    SECTION("everything filtered out") {
+        auto sv = fsv::filtered_string_view{"abc", [](const char&) { return false; }};
+        REQUIRE(sv.begin() == sv.end());
+        REQUIRE(sv.rbegin() == sv.rend());
+    }
+}
+
+TEST_CASE("char_class predicate") {
+    auto text = std::string(150, '.');
+    text[3] = 'x';
+    text[70] = 'y';
+    text[149] = 'x';
+    auto sv = fsv::filtered_string_view{text, fsv::char_class{"xy"}};
+
+    REQUIRE(sv.size() == 3);
+    REQUIRE(std::string(sv.begin(), sv.end()) == "xyx");
+    REQUIRE(std::string(sv.rbegin(), sv.rend()) == "xyx");
+    REQUIRE(&*std::prev(sv.end()) == &text[149]);
+    REQUIRE(&*std::next(sv.begin()) == &text[70]);
+
+    auto none = fsv::filtered_string_view{text, fsv::char_class{"z"}};
+    REQUIRE(none.begin() == none.end());
+
+    SECTION("dense matches across blocks, stepping both ways") {
+        auto dense = std::string{};
+        for (auto i = 0; i < 200; ++i) {
+            dense += static_cast<char>('a' + i % 7);
+        }
+        auto filtered = std::string{};
+        std::copy_if(dense.begin(), dense.end(), std::back_inserter(filtered), [](char c) { return c != 'c'; });
+        auto view = fsv::filtered_string_view{dense, !fsv::char_class{"c"}};
+        REQUIRE(std::string(view.begin(), view.end()) == filtered);
+
+        // a step back discards the cached block; the following steps forward must rebuild it
+        auto it = std::next(view.begin(), 60);
+        auto i = std::size_t{60};
+        for (auto step = 0; step < 50; ++step) {
+            ++it;
+            ++it;
+            --it;
+            i += 1;
+            REQUIRE(*it == filtered[i]);
+        }
+    }
+
+    SECTION("class iterators do not depend on the view") {
+        auto it = fsv::filtered_string_view{text, fsv::char_class{"xy"}}.begin();
+        REQUIRE(*it == 'x');
+        REQUIRE(*++it == 'y');
+        REQUIRE(*++it == 'x');
+    }
+}
+
+TEST_CASE("spaceship comparison") {
+    SECTION("unfiltered views") {
+        auto a = fsv::filtered_string_view{"apple"};
+        REQUIRE((a <=> fsv::filtered_string_view{"apply"}) == std::strong_ordering::less);
+        REQUIRE((a <=> fsv::filtered_string_view{"app"}) == std::strong_ordering::greater);
+        REQUIRE((a <=> fsv::filtered_string_view{"apple"}) == std::strong_ordering::equal);
+        REQUIRE((fsv::filtered_string_view{} <=> fsv::filtered_string_view{""}) == std::strong_ordering::equal);
+    }
+
+    SECTION("filtered against unfiltered") {
+        auto filtered = fsv::filtered_string_view{"a-p-p-l-e", [](const char& c) { return c != '-'; }};
+        REQUIRE((filtered <=> fsv::filtered_string_view{"apple"}) == std::strong_ordering::equal);
+        REQUIRE((fsv::filtered_string_view{"applf"} <=> filtered) == std::strong_ordering::greater);
+        REQUIRE((filtered <=> fsv::filtered_string_view{"apples"}) == std::strong_ordering::less);
+    }
+
+    SECTION("orders like std::string") {
+        auto words = std::vector<std::string>{"pear", "\xe9t\xe9", "apple", "", "app", "zebra"};
+        auto views = std::vector<fsv::filtered_string_view>(words.begin(), words.end());
+        auto sorted = words;
+        std::ranges::sort(sorted);
+        std::ranges::sort(views);
+        for (std::size_t i = 0; i < sorted.size(); ++i) {
+            REQUIRE(static_cast<std::string>(views[i]) == sorted[i]);
+        }
+    }
+}
+
+TEST_CASE("bulk output of runs") {
+    auto text = std::string{"ab--cd-e--fgh-"};
+    SECTION("lambda predicate") {
+        auto sv = fsv::filtered_string_view{text, [](const char& c) { return c != '-'; }};
+        std::ostringstream oss;
+        oss << sv;
+        REQUIRE(oss.str() == "abcdefgh");
+        REQUIRE(static_cast<std::string>(sv) == "abcdefgh");
+        REQUIRE(sv.size() == 8);
+    }
+
+    SECTION("char_class predicate") {
+        auto sv = fsv::filtered_string_view{text, fsv::char_class{"-"}};
+        std::ostringstream oss;
+        oss << sv;
+        REQUIRE(oss.str() == "------");
+        REQUIRE(static_cast<std::string>(sv) == "------");
+        REQUIRE(sv.size() == 6);
+    }
+
+    SECTION("runs across block boundaries") {
+        auto long_text = std::string(200, 'x');
+        for (std::size_t i = 0; i < long_text.size(); i += 3) {
+            long_text[i] = '_';
+        }
+        auto expected = long_text;
+        std::erase(expected, '_');
+        auto sv = fsv::filtered_string_view{long_text, fsv::char_class{"x"}};
+        REQUIRE(static_cast<std::string>(sv) == expected);
+        REQUIRE(sv.size() == expected.size());
+    }
+}
+
+TEST_CASE("hashing and heterogeneous lookup") {
+    auto spaced = fsv::filtered_string_view{"h e l l o", [](const char& c) { return c != ' '; }};
+    REQUIRE(fsv::hash{}(spaced) == fsv::hash{}(std::string{"hello"}));
+    REQUIRE(std::hash<fsv::filtered_string_view>{}(spaced) == fsv::hash{}(fsv::filtered_string_view{"hello"}));
+    REQUIRE(fsv::equal_to{}(spaced, std::string{"hello"}));
+
+    SECTION("unordered_set") {
+        auto words = std::unordered_set<std::string, fsv::hash, fsv::equal_to>{"hello", "world"};
+        REQUIRE(words.find(spaced) != words.end());
+        REQUIRE(words.contains(spaced));
+        REQUIRE_FALSE(words.contains(fsv::filtered_string_view{"h e l l o"}));
+    }
+
+    SECTION("unordered_map") {
+        auto counts = std::unordered_map<std::string, int, fsv::hash, fsv::equal_to>{{"hello", 1}};
+        auto it = counts.find(spaced);
+        REQUIRE(it != counts.end());
+        REQUIRE(it->second == 1);
+    }
+}
+
+TEST_CASE("substring search") {
+    SECTION("unfiltered") {
+        auto sv = fsv::filtered_string_view{"abracadabra"};
+        REQUIRE(sv.find("abra") == 0);
+        REQUIRE(sv.find("abra", 1) == 7);
+        REQUIRE(sv.find("abra", 8) == fsv::filtered_string_view::npos);
+        REQUIRE(sv.find("cad") == 4);
+        REQUIRE(sv.find("") == 0);
+        REQUIRE(sv.find("", 11) == 11);
+        REQUIRE(sv.find("", 12) == fsv::filtered_string_view::npos);
+        REQUIRE(sv.rfind("abra") == 7);
+        REQUIRE(sv.rfind("abra", 6) == 0);
+        REQUIRE(sv.rfind("zz") == fsv::filtered_string_view::npos);
+        REQUIRE(sv.contains("dab"));
+        REQUIRE_FALSE(sv.contains("dad"));
+        REQUIRE(sv.count("a") == 5);
+        REQUIRE(sv.count("abra") == 2);
+        REQUIRE(sv.count("") == 0);
+    }
+
+    SECTION("matches span filtered out characters") {
+        auto log = fsv::filtered_string_view{"er ror: time out, error", [](const char& c) { return c != ' '; }};
+        REQUIRE(log.find("error") == 0);
+        REQUIRE(log.find("error", 1) == 14);
+        REQUIRE(log.rfind("error") == 14);
+        REQUIRE(log.contains("timeout"));
+        REQUIRE(log.count("error") == 2);
+        REQUIRE(log.find("rr o") == fsv::filtered_string_view::npos);
+    }
+
+    SECTION("filtered pattern and overlapping candidates") {
+        auto sv = fsv::filtered_string_view{"aaaab", fsv::char_class{"ab"}};
+        auto pattern = fsv::filtered_string_view{"a-a-b", [](const char& c) { return c != '-'; }};
+        REQUIRE(sv.find(pattern) == 2);
+        REQUIRE(fsv::filtered_string_view{"aaaa", fsv::char_class{"a"}}.count("aa") == 2);
+        REQUIRE(fsv::filtered_string_view{"aaaa", fsv::char_class{"a"}}.rfind("aa") == 2);
+    }
+}
@@ -0,0 +1,265 @@
+#include "./filtered_string_view.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Benchmarks the filtered_string_view operations over a range of buffer lengths and predicate
+// pass rates. Results are written as CSV, one row per (op, predicate, pass rate, length), so runs
+// from two commits can be diffed directly. Under ctest only small buffers are measured; the
+// `benchmark` script runs the full range.
+//
+// Environment:
+//     FSV_BENCH_MAX     largest buffer length in bytes, always measured (default 4096, at most 1 GiB)
+//     FSV_BENCH_MIN_MS  minimum time spent measuring each row (default 1)
+//     FSV_BENCH_OUT     file to write the CSV to (default stdout)
+
+// Allocations are counted by replacing every global operator new and delete, so that memory from
+// any of the variants (the nothrow ones are used by Catch2) is released by the matching function.
+namespace {
+    std::atomic<std::size_t> allocations = 0;
+
+    auto counted_alloc(std::size_t n, std::size_t align = alignof(std::max_align_t)) noexcept -> void* {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        n = n == 0 ? 1 : n;
+        if (align <= alignof(std::max_align_t)) {
+            return std::malloc(n);
+        }
+        return std::aligned_alloc(align, (n + align - 1) / align * align);
+    }
+
+    auto checked(void* p) -> void* {
+        if (p == nullptr) {
+            throw std::bad_alloc{};
+        }
+        return p;
+    }
+} // namespace
+
+auto operator new(std::size_t n) -> void* {
+    return checked(counted_alloc(n));
+}
+auto operator new[](std::size_t n) -> void* {
+    return checked(counted_alloc(n));
+}
+auto operator new(std::size_t n, std::align_val_t align) -> void* {
+    return checked(counted_alloc(n, static_cast<std::size_t>(align)));
+}
+auto operator new[](std::size_t n, std::align_val_t align) -> void* {
+    return checked(counted_alloc(n, static_cast<std::size_t>(align)));
+}
+auto operator new(std::size_t n, const std::nothrow_t&) noexcept -> void* {
+    return counted_alloc(n);
+}
+auto operator new[](std::size_t n, const std::nothrow_t&) noexcept -> void* {
+    return counted_alloc(n);
+}
+auto operator new(std::size_t n, std::align_val_t align, const std::nothrow_t&) noexcept -> void* {
+    return counted_alloc(n, static_cast<std::size_t>(align));
+}
+auto operator new[](std::size_t n, std::align_val_t align, const std::nothrow_t&) noexcept -> void* {
+    return counted_alloc(n, static_cast<std::size_t>(align));
+}
+
+auto operator delete(void* p) noexcept -> void {
+    std::free(p);
+}
+auto operator delete[](void* p) noexcept -> void {
+    std::free(p);
+}
+auto operator delete(void* p, std::size_t) noexcept -> void {
+    std::free(p);
+}
+auto operator delete[](void* p, std::size_t) noexcept -> void {
+    std::free(p);
+}
+auto operator delete(void* p, std::align_val_t) noexcept -> void {
+    std::free(p);
+}
+auto operator delete[](void* p, std::align_val_t) noexcept -> void {
+    std::free(p);
+}
+auto operator delete(void* p, std::size_t, std::align_val_t) noexcept -> void {
+    std::free(p);
+}
+auto operator delete[](void* p, std::size_t, std::align_val_t) noexcept -> void {
+    std::free(p);
+}
+auto operator delete(void* p, const std::nothrow_t&) noexcept -> void {
+    std::free(p);
+}
+auto operator delete[](void* p, const std::nothrow_t&) noexcept -> void {
+    std::free(p);
+}
+auto operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept -> void {
+    std::free(p);
+}
+auto operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept -> void {
+    std::free(p);
+}
+
+namespace {
+    constexpr auto base = 27; // buffer bytes are base + [0, 100), so a pass rate in percent is a threshold
+    constexpr std::size_t max_length = std::size_t{1} << 30;
+
+    template<typename T>
+    auto keep(const T& value) -> void {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    // discards everything, so operator<< is measured without the cost of a real stream
+    class null_buffer : public std::streambuf {
+    protected:
+        auto overflow(int_type c) -> int_type override {
+            return traits_type::not_eof(c);
+        }
+        auto xsputn(const char*, std::streamsize n) -> std::streamsize override {
+            return n;
+        }
+    };
+
+    // 16 bytes and every fourth power of two after it up to max, then max itself if it falls between
+    auto buffer_lengths(std::size_t max) -> std::vector<std::size_t> {
+        auto lengths = std::vector<std::size_t>{};
+        for (auto length = std::size_t{16}; length <= max; length *= 4) {
+            lengths.push_back(length);
+        }
+        if (lengths.empty() || lengths.back() != max) {
+            lengths.push_back(max);
+        }
+        return lengths;
+    }
+
+    auto env_size(const char* name, std::size_t fallback) -> std::size_t {
+        const auto* value = std::getenv(name);
+        return value == nullptr ? fallback : static_cast<std::size_t>(std::stoull(value));
+    }
+
+    auto make_buffer(std::size_t length) -> std::string {
+        auto buffer = std::string(length, '\0');
+        auto state = std::uint64_t{0x9e3779b97f4a7c15};
+        for (auto& c : buffer) {
+            state = state * 6364136223846793005 + 1442695040888963407;
+            c = static_cast<char>(base + static_cast<int>((state >> 33) % 100));
+        }
+        return buffer;
+    }
+
+    struct predicate_kind {
+        std::string name;
+        std::function<fsv::filter(int)> make;
+    };
+
+    auto predicate_kinds() -> std::vector<predicate_kind> {
+        return {
+            {"default", [](int) { return fsv::filtered_string_view{}.predicate(); }},
+            {"lambda",
+             [](int rate) { return fsv::filter{[rate](const char& c) { return static_cast<int>(c) - base < rate; }}; }},
+            // a std::function of another signature, as filters loaded from configuration usually are
+            {"function",
+             [](int rate) {
+                 auto f = std::function<bool(char)>{[rate](char c) { return static_cast<int>(c) - base < rate; }};
+                 return fsv::filter{f};
+             }},
+            {"char_class",
+             [](int rate) {
+                 auto cls = fsv::char_class{};
+                 for (auto i = 0; i < rate; ++i) {
+                     cls.insert(static_cast<char>(base + i));
+                 }
+                 return fsv::filter{cls};
+             }},
+        };
+    }
+
+    struct result {
+        std::size_t reps = 0;
+        double ns_per_op = 0;
+        double allocs_per_op = 0;
+    };
+
+    template<typename Op>
+    auto measure(Op op, std::chrono::nanoseconds min_time) -> result {
+        const auto allocations_before = allocations.load();
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::nanoseconds{0};
+        auto reps = std::size_t{0};
+        do {
+            op();
+            ++reps;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed < min_time);
+        const auto allocated = allocations.load() - allocations_before;
+        return {reps,
+                static_cast<double>(elapsed.count()) / static_cast<double>(reps),
+                static_cast<double>(allocated) / static_cast<double>(reps)};
+    }
+} // namespace
+
+TEST_CASE("filtered_string_view benchmark") {
+    const auto max = std::min(env_size("FSV_BENCH_MAX", std::size_t{1} << 12), max_length);
+    const auto min_time = std::chrono::milliseconds{env_size("FSV_BENCH_MIN_MS", 1)};
+    auto file = std::ofstream{};
+    if (const auto* path = std::getenv("FSV_BENCH_OUT")) {
+        file.open(path);
+        REQUIRE(file);
+    }
+    auto& out = file.is_open() ? static_cast<std::ostream&>(file) : std::cout;
+
+    auto null = null_buffer{};
+    auto sink = std::ostream{&null};
+    const auto delimiter = std::string(1, static_cast<char>(base));
+    auto rows = std::size_t{0};
+
+    out << "op,predicate,pass_rate,bytes,reps,ns_per_op,ns_per_char,allocs_per_op\n";
+    for (const auto length : buffer_lengths(max)) {
+        const auto buffer = make_buffer(length);
+        for (const auto& kind : predicate_kinds()) {
+            for (auto rate : {1, 10, 50, 100}) {
+                if (kind.name == "default" && rate != 100) {
+                    continue;
+                }
+                const auto pred = kind.make(rate);
+                const auto view = fsv::filtered_string_view{buffer.data(), buffer.size(), pred};
+                const auto other = fsv::filtered_string_view{buffer.data(), buffer.size(), pred};
+                const auto tok = fsv::filtered_string_view{delimiter};
+                const auto size = view.size();
+                const auto mid = size / 2;
+                const auto second = fsv::filter{[](const char& c) { return c != base + 1; }};
+
+                auto report = [&](const char* op, auto body) {
+                    const auto r = measure(body, min_time);
+                    out << op << ',' << kind.name << ',' << rate << ',' << length << ',' << r.reps << ','
+                        << r.ns_per_op << ',' << r.ns_per_op / static_cast<double>(length) << ',' << r.allocs_per_op
+                        << '\n';
+                    ++rows;
+                };
+
+                report("size", [&] { keep(view.size()); });
+                if (size != 0) {
+                    report("index", [&] { keep(view[mid]); });
+                    report("at", [&] { keep(view.at(mid)); });
+                }
+                report("equal", [&] { keep(view == other); });
+                report("less", [&] { keep(view < other); });
+                report("ostream", [&] { sink << view; });
+                report("split", [&] { keep(fsv::split(view, tok)); });
+                report("substr", [&] { keep(fsv::substr(view, size / 4, size / 2)); });
+                report("compose", [&] { keep(fsv::compose(view, {pred, second}).size()); });
+            }
+        }
+    }
+    CHECK(rows != 0);
+}
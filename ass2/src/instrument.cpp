@@ -0,0 +1,89 @@
+#include "./instrument.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string_view>
+
+namespace fsv::instrument {
+    struct entry {
+        std::array<std::atomic<std::size_t>, 4> values{};
+    };
+
+    namespace {
+        // Entries are never erased, so scopes can keep pointers to them and count without locking.
+        struct registry {
+            std::mutex mutex;
+            std::map<std::string, entry, std::less<>> entries;
+
+            auto lookup(std::string_view tag) -> entry& {
+                const auto lock = std::scoped_lock{mutex};
+                auto it = entries.find(tag);
+                if (it == entries.end()) {
+                    it = entries.try_emplace(std::string{tag}).first;
+                }
+                return it->second;
+            }
+        };
+
+        auto get_registry() -> registry& {
+            static auto instance = registry{};
+            return instance;
+        }
+
+        auto untagged() -> entry& {
+            static auto& instance = get_registry().lookup("<untagged>");
+            return instance;
+        }
+
+        thread_local entry* current = nullptr;
+    } // namespace
+
+    scope::scope(const std::string& tag)
+    : previous_(current) {
+        current = &get_registry().lookup(tag);
+    }
+
+    scope::scope(std::source_location where)
+    : scope(std::string{where.file_name()} + ":" + std::to_string(where.line())) {}
+
+    scope::~scope() {
+        current = previous_;
+    }
+
+    auto add(counter c, std::size_t n) noexcept -> void {
+        auto& e = current != nullptr ? *current : untagged();
+        e.values[static_cast<std::size_t>(c)].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    auto snapshot() -> std::map<std::string, counts> {
+        auto& reg = get_registry();
+        const auto lock = std::scoped_lock{reg.mutex};
+        auto result = std::map<std::string, counts>{};
+        for (const auto& [tag, e] : reg.entries) {
+            result[tag] = counts{e.values[0].load(), e.values[1].load(), e.values[2].load(), e.values[3].load()};
+        }
+        return result;
+    }
+
+    auto dump(std::ostream& os) -> void {
+        os << "tag\tpredicate_calls\trescans\tindex_builds\tmaterializations\n";
+        for (const auto& [tag, c] : snapshot()) {
+            if (c != counts{}) {
+                os << tag << '\t' << c.predicate_calls << '\t' << c.rescans << '\t' << c.index_builds << '\t'
+                   << c.materializations << '\n';
+            }
+        }
+    }
+
+    auto reset() -> void {
+        auto& reg = get_registry();
+        const auto lock = std::scoped_lock{reg.mutex};
+        for (auto& [tag, e] : reg.entries) {
+            for (auto& value : e.values) {
+                value.store(0);
+            }
+        }
+    }
+} // namespace fsv::instrument
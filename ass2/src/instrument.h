@@ -0,0 +1,93 @@
+#ifndef COMP6771_ASS2_INSTRUMENT_H
+#define COMP6771_ASS2_INSTRUMENT_H
+
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <source_location>
+#include <string>
+
+// Opt-in counters for finding expensive access patterns, such as size() or operator[] in a loop.
+// Configure with -DFSV_INSTRUMENT=ON to compile them in; otherwise the FSV_INSTRUMENT_* macros
+// expand to nothing and the library does no counting.
+//
+// Counts go to the innermost active scope on the calling thread, or to "<untagged>":
+//     {
+//         FSV_INSTRUMENT_SCOPE("parse_headers"); // or FSV_INSTRUMENT_SCOPE() for "file:line"
+//         ...
+//     }
+//     fsv::instrument::dump(std::cerr);
+//
+// Predicate calls are those made through a type-erased filter, including the calls that composed,
+// split and substr'd filters make to the filters they wrap; characters tested by the char_class
+// block scan, or skipped by the default predicate, are not predicate calls.
+namespace fsv::instrument {
+#ifdef FSV_INSTRUMENT
+    inline constexpr bool enabled = true;
+#else
+    inline constexpr bool enabled = false;
+#endif
+
+    enum class counter {
+        predicate_calls,
+        rescans, // a walk from the start of a view: size(), empty(), operator[], at(), and the two
+                 // walks of a conversion to std::string
+        index_builds, // chunked_view and segmented_view prefix indexes
+        materializations, // conversions of a whole view to std::string
+    };
+
+    struct counts {
+        std::size_t predicate_calls = 0;
+        std::size_t rescans = 0;
+        std::size_t index_builds = 0;
+        std::size_t materializations = 0;
+
+        friend auto operator==(const counts&, const counts&) -> bool = default;
+    };
+
+    struct entry; // the counters of one tag
+
+    // Attributes counts on this thread to `tag` until destroyed. Scopes nest.
+    class scope {
+    public:
+        explicit scope(const std::string& tag);
+        explicit scope(std::source_location where = std::source_location::current());
+        scope(const scope&) = delete;
+        auto operator=(const scope&) -> scope& = delete;
+        ~scope();
+
+    private:
+        entry* previous_;
+    };
+
+    auto add(counter c, std::size_t n) noexcept -> void;
+    // counts per tag, for every tag seen since startup (reset() zeroes but keeps them)
+    [[nodiscard]] auto snapshot() -> std::map<std::string, counts>;
+    // one line per tag with a non-zero count
+    auto dump(std::ostream& os) -> void;
+    auto reset() -> void;
+} // namespace fsv::instrument
+
+#define FSV_INSTRUMENT_CONCAT_(a, b) a##b
+#define FSV_INSTRUMENT_CONCAT(a, b) FSV_INSTRUMENT_CONCAT_(a, b)
+
+#ifdef FSV_INSTRUMENT
+#define FSV_INSTRUMENT_COUNT(name, n) ::fsv::instrument::add(::fsv::instrument::counter::name, (n))
+#define FSV_INSTRUMENT_SCOPE(...) \
+    const ::fsv::instrument::scope FSV_INSTRUMENT_CONCAT(fsv_instrument_scope_, __LINE__){__VA_ARGS__}
+#else
+#define FSV_INSTRUMENT_COUNT(name, n) static_cast<void>(0)
+#define FSV_INSTRUMENT_SCOPE(...) static_cast<void>(0)
+#endif
+
+namespace fsv::instrument {
+    // Calls `pred` on `c` and counts it. Loops that know how many characters they tested count them
+    // in bulk with FSV_INSTRUMENT_COUNT instead.
+    template<typename Pred, typename T>
+    auto call(const Pred& pred, const T& c) -> bool {
+        FSV_INSTRUMENT_COUNT(predicate_calls, 1);
+        return pred(c);
+    }
+} // namespace fsv::instrument
+
+#endif // COMP6771_ASS2_INSTRUMENT_H
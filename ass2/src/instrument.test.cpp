@@ -0,0 +1,117 @@
+#include "./instrument.h"
+#include "./filtered_string_view.h"
+#include "./segmented_view.h"
+#include "./tokenizer.h"
+#include "./utf8_filtered_view.h"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    auto const no_spaces = [](const char& c) { return c != ' '; };
+} // namespace
+
+TEST_CASE("instrumentation counts per tag") {
+    fsv::instrument::reset();
+    auto view = fsv::filtered_string_view{"a b c d", no_spaces};
+    {
+        FSV_INSTRUMENT_SCOPE("indexing loop");
+        for (std::size_t i = 0; i < 4; ++i) {
+            static_cast<void>(view[i]);
+        }
+        static_cast<void>(view.at(3));
+    }
+    {
+        FSV_INSTRUMENT_SCOPE("conversion");
+        static_cast<void>(static_cast<std::string>(view));
+        {
+            FSV_INSTRUMENT_SCOPE("inner");
+            const auto pieces = std::vector<std::string>{"ab", "cd"};
+            auto rope = fsv::segmented_view{pieces};
+            static_cast<void>(rope);
+        }
+    }
+
+    const auto counts = fsv::instrument::snapshot();
+    if constexpr (fsv::instrument::enabled) {
+        const auto& loop = counts.at("indexing loop");
+        REQUIRE(loop.rescans == 5);
+        // view[i] tests characters up to and including the i-th passing one
+        REQUIRE(loop.predicate_calls == 1 + 3 + 5 + 7 + 7);
+        REQUIRE(loop.materializations == 0);
+
+        const auto& conversion = counts.at("conversion");
+        REQUIRE(conversion.materializations == 1);
+        // one walk to size the result and one to copy it, each testing all 7 characters once
+        REQUIRE(conversion.rescans == 2);
+        REQUIRE(conversion.predicate_calls == 2 * 7);
+        REQUIRE(counts.at("inner").index_builds == 1);
+
+        auto out = std::ostringstream{};
+        fsv::instrument::dump(out);
+        REQUIRE(out.str().find("indexing loop\t23\t5\t0\t0\n") != std::string::npos);
+
+        fsv::instrument::reset();
+        REQUIRE(fsv::instrument::snapshot().at("indexing loop") == fsv::instrument::counts{});
+    }
+    else {
+        for (const auto& [tag, c] : counts) {
+            REQUIRE(c == fsv::instrument::counts{});
+        }
+    }
+}
+
+TEST_CASE("predicate calls are counted outside the bulk scans") {
+    fsv::instrument::reset();
+    const auto text = fsv::filtered_string_view{"a,b c", no_spaces};
+    {
+        FSV_INSTRUMENT_SCOPE("tokenizer");
+        for (const auto& field : fsv::tokenizer{text, fsv::char_class{","}}) {
+            static_cast<void>(field);
+        }
+    }
+    {
+        FSV_INSTRUMENT_SCOPE("split_view");
+        for (const auto& slice : fsv::split_view{text, ","}) {
+            static_cast<void>(slice);
+        }
+    }
+    {
+        FSV_INSTRUMENT_SCOPE("compose");
+        const auto not_x = [](const char& c) { return c != 'x'; };
+        static_cast<void>(fsv::compose(fsv::filtered_string_view{"a b"}, {no_spaces, not_x}).size());
+    }
+    {
+        FSV_INSTRUMENT_SCOPE("utf8");
+        static_cast<void>(fsv::utf8_filtered_view{"\u00e9", [](char32_t) { return true; }}.size());
+    }
+
+    const auto counts = fsv::instrument::snapshot();
+    if constexpr (fsv::instrument::enabled) {
+        REQUIRE(counts.at("tokenizer").predicate_calls > 0);
+        REQUIRE(counts.at("split_view").predicate_calls > 0);
+        // 3 calls of the composed filter, which calls no_spaces 3 times and not_x for 'a' and 'b'
+        REQUIRE(counts.at("compose").predicate_calls == 3 + 3 + 2);
+        // the ASCII table, then the one non-ASCII code point
+        REQUIRE(counts.at("utf8").predicate_calls == 128 + 1);
+    }
+}
+
+TEST_CASE("scopes default to the call site") {
+    fsv::instrument::reset();
+    {
+        const auto here = fsv::instrument::scope{};
+        fsv::instrument::add(fsv::instrument::counter::rescans, 2);
+    }
+    fsv::instrument::add(fsv::instrument::counter::rescans, 1);
+
+    const auto counts = fsv::instrument::snapshot();
+    const auto tagged = std::find_if(counts.begin(), counts.end(), [](const auto& kv) {
+        return kv.first.find("instrument.test.cpp:") != std::string::npos;
+    });
+    REQUIRE(tagged != counts.end());
+    REQUIRE(tagged->second.rescans == 2);
+    REQUIRE(counts.at("<untagged>").rescans == 1);
+}
@@ -0,0 +1,159 @@
+#include "./segmented_view.h"
+#include "./instrument.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace fsv {
+    segmented_view::segmented_view(const std::vector<segment>& segments, filter predicate) {
+        parts_.reserve(segments.size());
+        for (const auto& seg : segments) {
+            parts_.emplace_back(seg.data(), seg.size(), predicate);
+        }
+        build_index();
+    }
+
+    segmented_view::segmented_view(const std::vector<std::string>& segments, filter predicate) {
+        parts_.reserve(segments.size());
+        for (const auto& seg : segments) {
+            parts_.emplace_back(seg.data(), seg.size(), predicate);
+        }
+        build_index();
+    }
+
+    auto segmented_view::build_index() -> void {
+        FSV_INSTRUMENT_COUNT(index_builds, 1);
+        prefix_.assign(parts_.size() + 1, 0);
+        for (std::size_t i = 0; i < parts_.size(); ++i) {
+            prefix_[i + 1] = prefix_[i] + parts_[i].size();
+        }
+    }
+
+    // size() is O(1), so this checks its argument; past the end, upper_bound would find no segment
+    auto segmented_view::operator[](std::size_t n) const -> const char& {
+        if (n >= size()) {
+            throw std::domain_error{"segmented_view::operator[](" + std::to_string(n) + "): invalid index"};
+        }
+        const auto it = std::upper_bound(prefix_.begin(), prefix_.end(), n);
+        const auto i = static_cast<std::size_t>(it - prefix_.begin()) - 1;
+        return parts_[i][n - prefix_[i]];
+    }
+
+    auto segmented_view::at(std::size_t index) const -> const char& {
+        if (index >= size()) {
+            throw std::domain_error{"segmented_view::at(" + std::to_string(index) + "): invalid index"};
+        }
+        return (*this)[index];
+    }
+
+    segmented_view::operator std::string() const {
+        auto result = std::string{};
+        result.reserve(size());
+        for (const auto& part : parts_) {
+            result += static_cast<std::string>(part);
+        }
+        return result;
+    }
+
+    auto segmented_view::size() const noexcept -> std::size_t {
+        return prefix_.back();
+    }
+
+    auto segmented_view::empty() const noexcept -> bool {
+        return size() == 0;
+    }
+
+    auto segmented_view::segment_count() const noexcept -> std::size_t {
+        return parts_.size();
+    }
+
+    auto segmented_view::segment_view(std::size_t i) const -> const filtered_string_view& {
+        return parts_[i];
+    }
+
+    auto segmented_view::begin() const -> const_iterator {
+        return iter{this, 0, false};
+    }
+    auto segmented_view::end() const -> const_iterator {
+        return iter{this, parts_.empty() ? 0 : parts_.size() - 1, true};
+    }
+    auto segmented_view::cbegin() const -> const_iterator {
+        return begin();
+    }
+    auto segmented_view::cend() const -> const_iterator {
+        return end();
+    }
+    auto segmented_view::rbegin() const -> const_reverse_iterator {
+        return const_reverse_iterator{end()};
+    }
+    auto segmented_view::rend() const -> const_reverse_iterator {
+        return const_reverse_iterator{begin()};
+    }
+    auto segmented_view::crbegin() const -> const_reverse_iterator {
+        return rbegin();
+    }
+    auto segmented_view::crend() const -> const_reverse_iterator {
+        return rend();
+    }
+
+    // The end iterator sits at the end of the last segment; any other iterator always points at
+    // a passing character, so segments with nothing left to show are skipped over eagerly.
+    segmented_view::iter::iter(const segmented_view* owner, std::size_t seg, bool at_end)
+    : owner_(owner) {
+        if (owner_->parts_.empty()) {
+            return;
+        }
+        enter(seg);
+        if (at_end) {
+            inner_ = end_;
+            return;
+        }
+        while (inner_ == end_ && seg_ + 1 < owner_->parts_.size()) {
+            enter(seg_ + 1);
+        }
+    }
+
+    auto segmented_view::iter::enter(std::size_t seg) -> void {
+        seg_ = seg;
+        begin_ = owner_->parts_[seg_].begin();
+        end_ = owner_->parts_[seg_].end();
+        inner_ = begin_;
+    }
+
+    auto segmented_view::iter::operator++() -> iter& {
+        ++inner_;
+        while (inner_ == end_ && seg_ + 1 < owner_->parts_.size()) {
+            enter(seg_ + 1);
+        }
+        return *this;
+    }
+
+    auto segmented_view::iter::operator--() -> iter& {
+        while (inner_ == begin_) {
+            enter(seg_ - 1);
+            inner_ = end_;
+        }
+        --inner_;
+        return *this;
+    }
+
+    auto segmented_view::iter::operator++(int) -> iter {
+        auto old = *this;
+        ++*this;
+        return old;
+    }
+
+    auto segmented_view::iter::operator--(int) -> iter {
+        auto old = *this;
+        --*this;
+        return old;
+    }
+
+    auto operator<<(std::ostream& os, const segmented_view& view) -> std::ostream& {
+        for (std::size_t i = 0; i < view.segment_count(); ++i) {
+            os << view.segment_view(i);
+        }
+        return os;
+    }
+} // namespace fsv
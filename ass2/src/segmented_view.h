@@ -0,0 +1,102 @@
+#ifndef COMP6771_ASS2_SEGMENTED_VIEW_H
+#define COMP6771_ASS2_SEGMENTED_VIEW_H
+
+#include "./filtered_string_view.h"
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace fsv {
+    // A filtered view over text split across several non-contiguous buffers (a rope), without
+    // concatenating them. Each segment is viewed by its own filtered_string_view, and a prefix sum
+    // of their sizes makes indexing a binary search over segments followed by a scan of one segment.
+    class segmented_view {
+        class iter {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = char;
+            using reference = const char&;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+
+            iter() = default;
+
+            auto operator*() const -> reference {
+                return *inner_;
+            }
+
+            auto operator++() -> iter&;
+            auto operator++(int) -> iter;
+            auto operator--() -> iter&;
+            auto operator--(int) -> iter;
+
+            friend auto operator==(const iter& lhs, const iter& rhs) -> bool {
+                return lhs.seg_ == rhs.seg_ && lhs.inner_ == rhs.inner_;
+            }
+
+        private:
+            using inner_t = filtered_string_view::const_iterator;
+
+            iter(const segmented_view* owner, std::size_t seg, bool at_end);
+            auto enter(std::size_t seg) -> void;
+
+            const segmented_view* owner_ = nullptr;
+            std::size_t seg_ = 0; // which segment we're looking at
+            inner_t inner_; // which character we're looking at in that segment
+            inner_t begin_; // the bounds of that segment
+            inner_t end_;
+
+            friend class segmented_view;
+        };
+
+    public:
+        using segment = std::span<const char>;
+
+        using iterator = iter;
+        using const_iterator = iter;
+        using reverse_iterator = std::reverse_iterator<iter>;
+        using const_reverse_iterator = std::reverse_iterator<iter>;
+
+        segmented_view() = default;
+        explicit segmented_view(const std::vector<segment>& segments,
+                                filter predicate = filtered_string_view::default_predicate);
+        explicit segmented_view(const std::vector<std::string>& segments,
+                                filter predicate = filtered_string_view::default_predicate);
+        // the view refers into the strings, so they must outlive it
+        explicit segmented_view(std::vector<std::string>&& segments,
+                                filter predicate = filtered_string_view::default_predicate) = delete;
+
+        // both throw std::domain_error if the index is not less than size()
+        auto operator[](std::size_t n) const -> const char&;
+        auto at(std::size_t index) const -> const char&;
+        explicit operator std::string() const;
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t;
+        [[nodiscard]] auto empty() const noexcept -> bool;
+        [[nodiscard]] auto segment_count() const noexcept -> std::size_t;
+        [[nodiscard]] auto segment_view(std::size_t i) const -> const filtered_string_view&;
+
+        [[nodiscard]] auto begin() const -> const_iterator;
+        [[nodiscard]] auto end() const -> const_iterator;
+        [[nodiscard]] auto cbegin() const -> const_iterator;
+        [[nodiscard]] auto cend() const -> const_iterator;
+        [[nodiscard]] auto rbegin() const -> const_reverse_iterator;
+        [[nodiscard]] auto rend() const -> const_reverse_iterator;
+        [[nodiscard]] auto crbegin() const -> const_reverse_iterator;
+        [[nodiscard]] auto crend() const -> const_reverse_iterator;
+
+    private:
+        auto build_index() -> void;
+
+        std::vector<filtered_string_view> parts_;
+        // prefix_[i] is the number of passing characters in the segments before segment i
+        std::vector<std::size_t> prefix_ = {0};
+    };
+
+    auto operator<<(std::ostream& os, const segmented_view& view) -> std::ostream&;
+} // namespace fsv
+
+#endif // COMP6771_ASS2_SEGMENTED_VIEW_H
@@ -0,0 +1,68 @@
+#include "./segmented_view.h"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("segmented_view over strings") {
+    const auto buffers = std::vector<std::string>{"GET /in", "", "dex.html HT", "TP/1.1", ""};
+    auto no_slash = [](const char& c) { return c != '/'; };
+    auto view = fsv::segmented_view{buffers, no_slash};
+
+    const auto expected = std::string{"GET index.html HTTP1.1"};
+    REQUIRE(view.segment_count() == 5);
+    REQUIRE(view.size() == expected.size());
+    REQUIRE(static_cast<std::string>(view) == expected);
+
+    SECTION("indexing across segment boundaries") {
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            REQUIRE(view[i] == expected[i]);
+        }
+        REQUIRE(&view[4] == &buffers[0][5]);
+        REQUIRE(&view[6] == &buffers[2][0]);
+        REQUIRE_THROWS_WITH(view.at(expected.size()), "segmented_view::at(22): invalid index");
+        REQUIRE_THROWS_WITH(view[expected.size()], "segmented_view::operator[](22): invalid index");
+    }
+
+    SECTION("iteration in both directions") {
+        static_assert(std::bidirectional_iterator<fsv::segmented_view::iterator>);
+        REQUIRE(std::string(view.begin(), view.end()) == expected);
+        auto reversed = expected;
+        std::ranges::reverse(reversed);
+        REQUIRE(std::string(view.rbegin(), view.rend()) == reversed);
+        REQUIRE(*std::prev(view.end()) == '1');
+    }
+
+    SECTION("stream output") {
+        auto oss = std::ostringstream{};
+        oss << view;
+        REQUIRE(oss.str() == expected);
+    }
+}
+
+TEST_CASE("segmented_view over spans") {
+    const char first[] = {'a', 'b', 'c'};
+    const char second[] = {'d', 'e'};
+    auto view = fsv::segmented_view{std::vector<fsv::segmented_view::segment>{first, second},
+                                    [](const char& c) { return c != 'c' && c != 'd'; }};
+    REQUIRE(static_cast<std::string>(view) == "abe");
+    REQUIRE(view[2] == 'e');
+}
+
+TEST_CASE("segmented_view with nothing to show") {
+    auto none = fsv::segmented_view{};
+    REQUIRE(none.empty());
+    REQUIRE(none.begin() == none.end());
+
+    static_assert(!std::is_constructible_v<fsv::segmented_view, std::vector<std::string>&&>);
+    const auto strings = std::vector<std::string>{"aa", "", "aaa"};
+    auto filtered = fsv::segmented_view{strings, fsv::char_class{"b"}};
+    REQUIRE(filtered.empty());
+    REQUIRE(filtered.begin() == filtered.end());
+    REQUIRE(filtered.rbegin() == filtered.rend());
+    REQUIRE_THROWS_AS(none[0], std::domain_error);
+    REQUIRE_THROWS_AS(filtered[0], std::domain_error);
+}
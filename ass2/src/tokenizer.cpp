@@ -0,0 +1,195 @@
+#include "./tokenizer.h"
+#include "./instrument.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace fsv {
+    namespace {
+        constexpr std::size_t simd_block = 32;
+        constexpr std::size_t class_block = 64;
+    } // namespace
+
+    tokenizer::tokenizer(const filtered_string_view& text, const char_class& delimiters, std::optional<char> quote)
+    : text_(text)
+    , quote_(quote)
+    , pred_(text.predicate().target_type() == filtered_string_view::default_predicate.target_type()
+                ? nullptr
+                : std::make_shared<const filter>(text.predicate())) {
+        auto make_set = [](const char_class& cls) {
+            auto set = byte_set{cls};
+            for (auto c = 0; c < 256; ++c) {
+                const auto ch = static_cast<char>(c);
+                if (!cls.contains(ch)) {
+                    continue;
+                }
+                if (set.count == set.bytes.size()) {
+                    return set;
+                }
+                set.bytes[set.count++] = ch;
+            }
+            set.small = true;
+            return set;
+        };
+        delims_ = make_set(delimiters);
+        if (quote_) {
+            auto q = char_class{};
+            q.insert(*quote_);
+            quotes_ = make_set(q);
+        }
+    }
+
+    // the first passing character in [from, end of text) that is in `set`, or the end
+    auto tokenizer::find(const char* from, const byte_set& set) const -> const char* {
+        const char* last = text_.ptr_ + text_.length_;
+        if (pred_ != nullptr) {
+            while (from != last && !(set.cls.contains(*from) && instrument::call(text_.pred_, *from))) {
+                ++from;
+            }
+            return from;
+        }
+#ifdef __SSE2__
+        if (set.small) {
+            for (; static_cast<std::size_t>(last - from) >= simd_block; from += simd_block) {
+                const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from));
+                const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from + 16));
+                auto lo_eq = _mm_setzero_si128();
+                auto hi_eq = _mm_setzero_si128();
+                for (std::size_t i = 0; i < set.count; ++i) {
+                    const auto needle = _mm_set1_epi8(set.bytes[i]);
+                    lo_eq = _mm_or_si128(lo_eq, _mm_cmpeq_epi8(lo, needle));
+                    hi_eq = _mm_or_si128(hi_eq, _mm_cmpeq_epi8(hi, needle));
+                }
+                const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(lo_eq))
+                                  | static_cast<std::uint32_t>(_mm_movemask_epi8(hi_eq)) << 16U;
+                if (mask != 0) {
+                    return from + std::countr_zero(mask);
+                }
+            }
+        }
+#endif
+        while (from != last) {
+            const auto n = std::min(class_block, static_cast<std::size_t>(last - from));
+            const auto mask = set.cls.match_mask(from, n);
+            if (mask != 0) {
+                return from + std::countr_zero(mask);
+            }
+            from += n;
+        }
+        return last;
+    }
+
+    auto tokenizer::next_passing(const char* from) const -> const char* {
+        const char* last = text_.ptr_ + text_.length_;
+        while (from != last && !instrument::call(text_.pred_, *from)) {
+            ++from;
+        }
+        return from;
+    }
+
+    auto tokenizer::read(const char* from) const -> iter {
+        const char* last = text_.ptr_ + text_.length_;
+        auto it = iter{};
+        it.owner_ = this;
+        it.start_ = from;
+        it.done_ = false;
+
+        const char* open = quote_ ? next_passing(from) : last;
+        const char* delim = nullptr;
+        // the first passing character decides, as any delimiter before it would itself be that character
+        if (open != last && *open == *quote_ && !delims_.cls.contains(*open)) {
+            it.first_ = open + 1;
+            const char* close = find(it.first_, quotes_);
+            for (; close != last; close = find(close + 1, quotes_)) {
+                const char* after = next_passing(close + 1);
+                if (after == last || *after != *quote_) {
+                    break;
+                }
+                it.escaped_ = true;
+                close = after;
+            }
+            it.last_ = close;
+            delim = close == last ? last : find(close + 1, delims_);
+        }
+        else {
+            delim = find(from, delims_);
+            it.first_ = from;
+            it.last_ = delim;
+        }
+        it.next_ = delim == last ? nullptr : delim + 1;
+        return it;
+    }
+
+    auto tokenizer::begin() const -> iterator {
+        return read(text_.ptr_);
+    }
+
+    auto tokenizer::end() const -> iterator {
+        auto it = iter{};
+        it.owner_ = this;
+        it.start_ = text_.ptr_ + text_.length_;
+        return it;
+    }
+
+    // each field's filter captures a pointer to the shared predicate, so making one never copies it
+    auto tokenizer::iter::operator*() const -> filtered_string_view {
+        const auto* pred = owner_->pred_.get();
+        const auto len = static_cast<std::size_t>(last_ - first_);
+        if (!escaped_) {
+            if (pred == nullptr) {
+                return filtered_string_view{first_, len, filtered_string_view::default_predicate};
+            }
+            return filtered_string_view{first_, len, [pred](const char& c) { return instrument::call(*pred, c); }};
+        }
+        // keeps the second quote of each doubled pair, counting passing quotes back to the field start
+        const auto quote = *owner_->quote_;
+        if (pred == nullptr) {
+            return filtered_string_view{first_, len, [first = first_, quote](const char& c) {
+                                            std::size_t run = 0;
+                                            for (const char* p = &c; p != first && p[-1] == quote; --p) {
+                                                ++run;
+                                            }
+                                            return c != quote || run % 2 == 1;
+                                        }};
+        }
+        return filtered_string_view{first_, len, [first = first_, quote, pred](const char& c) {
+                                        if (!instrument::call(*pred, c)) {
+                                            return false;
+                                        }
+                                        std::size_t run = 0;
+                                        for (const char* p = &c; p != first;) {
+                                            --p;
+                                            if (!instrument::call(*pred, *p)) {
+                                                continue;
+                                            }
+                                            if (*p != quote) {
+                                                break;
+                                            }
+                                            ++run;
+                                        }
+                                        return c != quote || run % 2 == 1;
+                                    }};
+    }
+
+    auto tokenizer::iter::operator++() -> iter& {
+        if (next_ == nullptr) {
+            start_ = owner_->text_.ptr_ + owner_->text_.length_;
+            done_ = true;
+        }
+        else {
+            *this = owner_->read(next_);
+        }
+        return *this;
+    }
+
+    auto tokenizer::iter::operator++(int) -> iter {
+        auto old = *this;
+        ++*this;
+        return old;
+    }
+} // namespace fsv
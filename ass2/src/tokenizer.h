@@ -0,0 +1,91 @@
+#ifndef COMP6771_ASS2_TOKENIZER_H
+#define COMP6771_ASS2_TOKENIZER_H
+
+#include "./filtered_string_view.h"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+
+namespace fsv {
+    // Lazily splits the filtered text of a view into fields separated by any character of a
+    // delimiter set, with the same edge cases as `split`: adjacent delimiters give empty fields,
+    // and empty text gives one empty field. Fields are filtered_string_views over the raw text.
+    //
+    // Given a quote character, fields that start with it are quoted as in CSV (RFC 4180):
+    // delimiters inside quotes are part of the field, a doubled quote stands for one quote, and
+    // the field's view skips the enclosing quotes and the escaping halves of doubled quotes. Text
+    // between a closing quote and the next delimiter is ignored; an unclosed quote runs to the end.
+    //
+    // Over the default predicate, delimiters are found 32 bytes at a time with SSE2 compares when
+    // there are at most eight delimiter bytes, and 64 at a time by char_class::match_mask otherwise.
+    //
+    // Like split_view's slices, fields refer to the predicate shared by the tokenizer and its copies
+    // instead of copying it, so they must not outlive all of them (unless `text` uses the default).
+    class tokenizer : public std::ranges::view_interface<tokenizer> {
+        struct byte_set {
+            char_class cls;
+            std::array<char, 8> bytes{};
+            std::size_t count = 0;
+            bool small = false;
+        };
+
+        class iter {
+        public:
+            using iterator_concept = std::forward_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = filtered_string_view;
+            using difference_type = std::ptrdiff_t;
+            using reference = filtered_string_view;
+            using pointer = void;
+
+            iter() = default;
+
+            auto operator*() const -> filtered_string_view;
+            auto operator++() -> iter&;
+            auto operator++(int) -> iter;
+
+            friend auto operator==(const iter& lhs, const iter& rhs) -> bool {
+                return lhs.start_ == rhs.start_ && lhs.done_ == rhs.done_;
+            }
+
+        private:
+            const tokenizer* owner_ = nullptr;
+            const char* start_ = nullptr; // where the field starts, including any opening quote
+            const char* first_ = nullptr; // the field's contents are [first_, last_)
+            const char* last_ = nullptr;
+            const char* next_ = nullptr; // start of the following field, or null if this is the last
+            bool escaped_ = false; // contents hold doubled quotes
+            bool done_ = true;
+
+            friend class tokenizer;
+        };
+
+    public:
+        using iterator = iter;
+        using const_iterator = iter;
+
+        tokenizer() = default;
+        tokenizer(const filtered_string_view& text, const char_class& delimiters, std::optional<char> quote = {});
+
+        [[nodiscard]] auto begin() const -> iterator;
+        [[nodiscard]] auto end() const -> iterator;
+
+    private:
+        auto read(const char* from) const -> iter;
+        auto find(const char* from, const byte_set& set) const -> const char*;
+        auto next_passing(const char* from) const -> const char*;
+
+        filtered_string_view text_;
+        byte_set delims_;
+        byte_set quotes_;
+        std::optional<char> quote_;
+        // text_'s predicate, held once so that every field can point at it; null if it's the default
+        std::shared_ptr<const filter> pred_;
+    };
+} // namespace fsv
+
+#endif // COMP6771_ASS2_TOKENIZER_H
@@ -0,0 +1,102 @@
+#include "./tokenizer.h"
+#include <catch2/catch.hpp>
+#include <array>
+#include <string>
+#include <vector>
+
+namespace {
+    auto fields(const fsv::tokenizer& tok) -> std::vector<std::string> {
+        auto result = std::vector<std::string>{};
+        for (const auto& field : tok) {
+            result.push_back(static_cast<std::string>(field));
+        }
+        return result;
+    }
+
+    using strings = std::vector<std::string>;
+} // namespace
+
+TEST_CASE("tokenizing on a delimiter set") {
+    const auto text = std::string{"name,age\tcity\nann,31\tparis"};
+    auto tok = fsv::tokenizer{text, fsv::char_class{",\t\n"}};
+    REQUIRE(fields(tok) == strings{"name", "age", "city", "ann", "31", "paris"});
+    REQUIRE((*tok.begin()).data() == text.data());
+
+    SECTION("same edge cases as split") {
+        REQUIRE(fields(fsv::tokenizer{"", fsv::char_class{","}}) == strings{""});
+        REQUIRE(fields(fsv::tokenizer{",", fsv::char_class{","}}) == strings{"", ""});
+        REQUIRE(fields(fsv::tokenizer{"a,;b;", fsv::char_class{",;"}}) == strings{"a", "", "b", ""});
+        REQUIRE(fields(fsv::tokenizer{"abc", fsv::char_class{}}) == strings{"abc"});
+
+        auto sv = fsv::filtered_string_view{"xax"};
+        auto split = fsv::split(sv, fsv::filtered_string_view{"x"});
+        auto tokens = fsv::tokenizer{sv, fsv::char_class{"x"}};
+        REQUIRE(std::ranges::equal(split, tokens));
+    }
+
+    SECTION("filtered text") {
+        auto no_spaces = fsv::filtered_string_view{" a , b ,c ", [](const char& c) { return c != ' '; }};
+        REQUIRE(fields(fsv::tokenizer{no_spaces, fsv::char_class{", "}}) == strings{"a", "b", "c"});
+    }
+
+    SECTION("the iterator is a forward iterator") {
+        static_assert(std::forward_iterator<fsv::tokenizer::iterator>);
+        auto it = tok.begin();
+        auto copy = it++;
+        REQUIRE(static_cast<std::string>(*copy) == "name");
+        REQUIRE(static_cast<std::string>(*it) == "age");
+        REQUIRE(std::ranges::distance(tok) == 6);
+    }
+}
+
+TEST_CASE("long input takes the block scanning paths") {
+    auto line = std::string{};
+    auto expected = strings{};
+    for (auto i = 0; i < 200; ++i) {
+        expected.push_back(std::string(static_cast<std::size_t>(i % 41), static_cast<char>('a' + i % 26)));
+        line += expected.back() + (i % 3 == 0 ? "," : i % 3 == 1 ? "\t" : "\n");
+    }
+    expected.emplace_back();
+    REQUIRE(fields(fsv::tokenizer{line, fsv::char_class{",\t\n"}}) == expected);
+    // more delimiter bytes than fit the SIMD compare set
+    REQUIRE(fields(fsv::tokenizer{line, fsv::char_class{",\t\n0123456789"}}) == expected);
+}
+
+TEST_CASE("quote-aware CSV mode") {
+    auto csv = [](const char* text) { return fields(fsv::tokenizer{text, fsv::char_class{",\n"}, '"'}); };
+    REQUIRE(csv(R"(a,"b,c",d)") == strings{"a", "b,c", "d"});
+    REQUIRE(csv(R"("say ""hi""",x)") == strings{R"(say "hi")", "x"});
+    REQUIRE(csv(R"("""","""""")") == strings{R"(")", R"("")"});
+    REQUIRE(csv(R"("",)") == strings{"", ""});
+    REQUIRE(csv("\"multi\nline\"\nnext") == strings{"multi\nline", "next"});
+    REQUIRE(csv(R"(mid"quote,x)") == strings{R"(mid"quote)", "x"});
+    REQUIRE(csv(R"("closed"junk,x)") == strings{"closed", "x"});
+    REQUIRE(csv(R"("unclosed,x)") == strings{"unclosed,x"});
+
+    SECTION("with a filtered source") {
+        auto no_spaces = fsv::filtered_string_view{R"( "a "" b" , c)", [](const char& c) { return c != ' '; }};
+        REQUIRE(fields(fsv::tokenizer{no_spaces, fsv::char_class{","}, '"'}) == strings{R"(a"b)", "c"});
+    }
+}
+
+TEST_CASE("fields share the predicate instead of copying it") {
+    struct counted_not_space {
+        int* copies;
+        std::array<char, 64> padding{}; // too big for std::function's small buffer
+        counted_not_space(int* c)
+        : copies(c) {}
+        counted_not_space(const counted_not_space& other)
+        : copies(other.copies) {
+            ++*copies;
+        }
+        auto operator()(const char& c) const -> bool {
+            return c != ' ';
+        }
+    };
+    auto copies = 0;
+    const auto text = fsv::filtered_string_view{R"(a b,"c "" d",e f)", counted_not_space{&copies}};
+    const auto tok = fsv::tokenizer{text, fsv::char_class{","}, '"'};
+    const auto before = copies;
+    REQUIRE(fields(tok) == strings{"ab", R"(c"d)", "ef"});
+    REQUIRE(copies == before);
+}
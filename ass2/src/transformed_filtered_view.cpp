@@ -0,0 +1,170 @@
+#include "./transformed_filtered_view.h"
+#include "./instrument.h"
+
+#include <algorithm>
+#include <tuple>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace fsv {
+    namespace {
+        constexpr std::size_t stage_size = 256;
+
+        // shifts bytes in [lo, hi] by `delta`, 16 at a time; returns how many bytes were mapped
+        auto shift_range([[maybe_unused]] const char* src,
+                         [[maybe_unused]] std::size_t n,
+                         [[maybe_unused]] char* dst,
+                         [[maybe_unused]] char lo,
+                         [[maybe_unused]] char hi,
+                         [[maybe_unused]] char delta) noexcept -> std::size_t {
+            std::size_t i = 0;
+#ifdef __SSE2__
+            // signed compares suffice: both bounds are ASCII, and bytes >= 0x80 compare negative
+            const auto below = _mm_set1_epi8(static_cast<char>(lo - 1));
+            const auto above = _mm_set1_epi8(static_cast<char>(hi + 1));
+            const auto shift = _mm_set1_epi8(delta);
+            for (; i + 16 <= n; i += 16) {
+                const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const auto in_range = _mm_and_si128(_mm_cmpgt_epi8(v, below), _mm_cmplt_epi8(v, above));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                                 _mm_add_epi8(v, _mm_and_si128(in_range, shift)));
+            }
+#endif
+            return i;
+        }
+
+        template<typename L, typename R>
+        auto compare(L l, L l_end, R r, R r_end) -> std::strong_ordering {
+            for (; l != l_end && r != r_end; ++l, ++r) {
+                if (*l != *r) {
+                    return static_cast<unsigned char>(*l) <=> static_cast<unsigned char>(*r);
+                }
+            }
+            if (l != l_end) {
+                return std::strong_ordering::greater;
+            }
+            if (r != r_end) {
+                return std::strong_ordering::less;
+            }
+            return std::strong_ordering::equal;
+        }
+    } // namespace
+
+    auto char_map::apply(const char* src, std::size_t n, char* dst) const noexcept -> void {
+        std::size_t done = 0;
+        switch (kind_) {
+        case kind::identity: std::copy(src, src + n, dst); return;
+        case kind::lower: done = shift_range(src, n, dst, 'A', 'Z', 'a' - 'A'); break;
+        case kind::upper: done = shift_range(src, n, dst, 'a', 'z', static_cast<char>('A' - 'a')); break;
+        case kind::table: break;
+        }
+        for (std::size_t i = done; i < n; ++i) {
+            dst[i] = (*this)(src[i]);
+        }
+    }
+
+    transformed_filtered_view::transformed_filtered_view(filtered_string_view view, const char_map& map)
+    : base_(std::move(view))
+    , map_(map) {}
+
+    template<typename F>
+    auto transformed_filtered_view::for_each_mapped(F&& visit) const -> void {
+        char stage[stage_size];
+        const char* last = base_.ptr_ + base_.length_;
+        for (auto [first, run_end] = base_.next_run(base_.ptr_); first != last;
+             std::tie(first, run_end) = base_.next_run(run_end)) {
+            while (first != run_end) {
+                const auto n = std::min(stage_size, static_cast<std::size_t>(run_end - first));
+                map_.apply(first, n, stage);
+                visit(static_cast<const char*>(stage), n);
+                first += n;
+            }
+        }
+    }
+
+    transformed_filtered_view::operator std::string() const {
+        FSV_INSTRUMENT_COUNT(materializations, 1);
+        auto result = std::string{};
+        const char* last = base_.ptr_ + base_.length_;
+        for (auto [first, run_end] = base_.next_run(base_.ptr_); first != last;
+             std::tie(first, run_end) = base_.next_run(run_end)) {
+            const auto offset = result.size();
+            const auto n = static_cast<std::size_t>(run_end - first);
+            result.resize(offset + n);
+            map_.apply(first, n, result.data() + offset);
+        }
+        return result;
+    }
+
+    auto transformed_filtered_view::size() const -> std::size_t {
+        return base_.size();
+    }
+
+    auto transformed_filtered_view::empty() const -> bool {
+        return base_.empty();
+    }
+
+    auto transformed_filtered_view::base() const noexcept -> const filtered_string_view& {
+        return base_;
+    }
+
+    auto transformed_filtered_view::map() const noexcept -> const char_map& {
+        return map_;
+    }
+
+    auto transformed_filtered_view::begin() const -> const_iterator {
+        return iter{base_.begin(), &map_};
+    }
+
+    auto transformed_filtered_view::end() const -> const_iterator {
+        return iter{base_.end(), &map_};
+    }
+
+    auto transformed_filtered_view::rbegin() const -> const_reverse_iterator {
+        return const_reverse_iterator{end()};
+    }
+
+    auto transformed_filtered_view::rend() const -> const_reverse_iterator {
+        return const_reverse_iterator{begin()};
+    }
+
+    auto operator==(const transformed_filtered_view& lhs, const transformed_filtered_view& rhs) -> bool {
+        return compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) == std::strong_ordering::equal;
+    }
+
+    auto operator==(const transformed_filtered_view& lhs, const filtered_string_view& rhs) -> bool {
+        return compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) == std::strong_ordering::equal;
+    }
+
+    auto operator<=>(const transformed_filtered_view& lhs, const transformed_filtered_view& rhs)
+        -> std::strong_ordering {
+        return compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    auto operator<=>(const transformed_filtered_view& lhs, const filtered_string_view& rhs) -> std::strong_ordering {
+        return compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    auto operator<<(std::ostream& os, const transformed_filtered_view& view) -> std::ostream& {
+        view.for_each_mapped(
+            [&os](const char* first, std::size_t n) { os.write(first, static_cast<std::streamsize>(n)); });
+        return os;
+    }
+
+    // the same FNV-1a as for filtered_string_view, over the mapped characters
+    auto hash::operator()(const transformed_filtered_view& view) const -> std::size_t {
+        auto h = fnv_offset_basis;
+        view.for_each_mapped([&h](const char* first, std::size_t n) { h = fnv1a(h, first, n); });
+        return static_cast<std::size_t>(h);
+    }
+
+    auto equal_to::operator()(const transformed_filtered_view& lhs, const filtered_string_view& rhs) const -> bool {
+        return lhs == rhs;
+    }
+
+    auto equal_to::operator()(const filtered_string_view& lhs, const transformed_filtered_view& rhs) const -> bool {
+        return rhs == lhs;
+    }
+} // namespace fsv
@@ -0,0 +1,168 @@
+#ifndef COMP6771_ASS2_TRANSFORMED_FILTERED_VIEW_H
+#define COMP6771_ASS2_TRANSFORMED_FILTERED_VIEW_H
+
+#include "./filtered_string_view.h"
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <string>
+
+namespace fsv {
+    // A byte-to-byte mapping given by a 256-entry table. ASCII case folding is recognised and
+    // applied 16 bytes at a time; other tables are applied by lookup.
+    class char_map {
+    public:
+        // the identity
+        constexpr char_map() noexcept {
+            for (std::size_t i = 0; i < table_.size(); ++i) {
+                table_[i] = static_cast<char>(i);
+            }
+        }
+        constexpr explicit char_map(const std::array<char, 256>& table) noexcept
+        : table_(table)
+        , kind_(kind::table) {}
+
+        [[nodiscard]] static constexpr auto to_lower() noexcept -> char_map {
+            auto map = char_map{};
+            for (auto c = 'A'; c <= 'Z'; ++c) {
+                map.table_[static_cast<unsigned char>(c)] = static_cast<char>(c - 'A' + 'a');
+            }
+            map.kind_ = kind::lower;
+            return map;
+        }
+        [[nodiscard]] static constexpr auto to_upper() noexcept -> char_map {
+            auto map = char_map{};
+            for (auto c = 'a'; c <= 'z'; ++c) {
+                map.table_[static_cast<unsigned char>(c)] = static_cast<char>(c - 'a' + 'A');
+            }
+            map.kind_ = kind::upper;
+            return map;
+        }
+
+        constexpr auto set(char from, char to) noexcept -> void {
+            table_[static_cast<unsigned char>(from)] = to;
+            kind_ = kind::table;
+        }
+        constexpr auto operator()(char c) const noexcept -> char {
+            return table_[static_cast<unsigned char>(c)];
+        }
+
+        // writes the mapping of [src, src + n) to dst
+        auto apply(const char* src, std::size_t n, char* dst) const noexcept -> void;
+
+    private:
+        enum class kind { identity, lower, upper, table };
+
+        std::array<char, 256> table_{};
+        kind kind_ = kind::identity;
+    };
+
+    // A filtered_string_view whose characters are passed through a char_map as they are read, so
+    // filtering and normalising happen in one pass without an intermediate string. Comparison,
+    // hashing and output see the mapped characters; a view hashes like the string it would produce.
+    class transformed_filtered_view {
+        class iter {
+        public:
+            using iterator_concept = std::bidirectional_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = char;
+            using reference = char;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+
+            iter() = default;
+
+            auto operator*() const -> reference {
+                return (*map_)(*it_);
+            }
+
+            auto operator++() -> iter& {
+                ++it_;
+                return *this;
+            }
+            auto operator++(int) -> iter {
+                auto old = *this;
+                ++*this;
+                return old;
+            }
+            auto operator--() -> iter& {
+                --it_;
+                return *this;
+            }
+            auto operator--(int) -> iter {
+                auto old = *this;
+                --*this;
+                return old;
+            }
+
+            // the underlying, unmapped character
+            [[nodiscard]] auto base() const -> filtered_string_view::const_iterator {
+                return it_;
+            }
+
+            friend auto operator==(const iter& lhs, const iter& rhs) -> bool {
+                return lhs.it_ == rhs.it_;
+            }
+
+        private:
+            iter(filtered_string_view::const_iterator it, const char_map* map)
+            : it_(it)
+            , map_(map) {}
+
+            filtered_string_view::const_iterator it_;
+            const char_map* map_ = nullptr;
+
+            friend class transformed_filtered_view;
+        };
+
+    public:
+        using iterator = iter;
+        using const_iterator = iter;
+        using reverse_iterator = std::reverse_iterator<iter>;
+        using const_reverse_iterator = std::reverse_iterator<iter>;
+
+        transformed_filtered_view() = default;
+        transformed_filtered_view(filtered_string_view view, const char_map& map);
+
+        explicit operator std::string() const;
+
+        [[nodiscard]] auto size() const -> std::size_t;
+        [[nodiscard]] auto empty() const -> bool;
+        [[nodiscard]] auto base() const noexcept -> const filtered_string_view&;
+        [[nodiscard]] auto map() const noexcept -> const char_map&;
+
+        [[nodiscard]] auto begin() const -> const_iterator;
+        [[nodiscard]] auto end() const -> const_iterator;
+        [[nodiscard]] auto rbegin() const -> const_reverse_iterator;
+        [[nodiscard]] auto rend() const -> const_reverse_iterator;
+
+        friend auto operator==(const transformed_filtered_view& lhs, const transformed_filtered_view& rhs) -> bool;
+        friend auto operator==(const transformed_filtered_view& lhs, const filtered_string_view& rhs) -> bool;
+        friend auto operator<=>(const transformed_filtered_view& lhs, const transformed_filtered_view& rhs)
+            -> std::strong_ordering;
+        friend auto operator<=>(const transformed_filtered_view& lhs, const filtered_string_view& rhs)
+            -> std::strong_ordering;
+        friend auto operator<<(std::ostream& os, const transformed_filtered_view& view) -> std::ostream&;
+        friend struct hash;
+
+    private:
+        // calls visit(first, n) on each run of mapped characters, staged through a small buffer
+        template<typename F>
+        auto for_each_mapped(F&& visit) const -> void;
+
+        filtered_string_view base_;
+        char_map map_;
+    };
+} // namespace fsv
+
+template<>
+struct std::hash<fsv::transformed_filtered_view> {
+    auto operator()(const fsv::transformed_filtered_view& view) const -> std::size_t {
+        return fsv::hash{}(view);
+    }
+};
+
+#endif // COMP6771_ASS2_TRANSFORMED_FILTERED_VIEW_H
@@ -0,0 +1,91 @@
+#include "./transformed_filtered_view.h"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cctype>
+#include <array>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+
+namespace {
+    auto const no_digits = [](const char& c) { return c < '0' || c > '9'; };
+} // namespace
+
+TEST_CASE("char_map") {
+    constexpr auto lower = fsv::char_map::to_lower();
+    static_assert(lower('Q') == 'q' && lower('q') == 'q' && lower('@') == '@' && lower('[') == '[');
+    constexpr auto upper = fsv::char_map::to_upper();
+    static_assert(upper('q') == 'Q' && upper('`') == '`' && upper('{') == '{');
+    static_assert(fsv::char_map{}('\xFF') == '\xFF');
+
+    SECTION("bulk application agrees with lookup") {
+        auto src = std::string{};
+        for (auto i = 0; i < 3 * 256 + 5; ++i) {
+            src += static_cast<char>(i);
+        }
+        auto rot = std::array<char, 256>{};
+        for (std::size_t i = 0; i < rot.size(); ++i) {
+            rot[i] = static_cast<char>(i + 13);
+        }
+        auto dashes = fsv::char_map::to_lower();
+        dashes.set('_', '-');
+        for (const auto& map : {fsv::char_map{}, lower, upper, fsv::char_map{rot}, dashes}) {
+            auto dst = std::string(src.size(), '\0');
+            map.apply(src.data(), src.size(), dst.data());
+            auto expected = std::string(src.size(), '\0');
+            std::transform(src.begin(), src.end(), expected.begin(), [&map](char c) { return map(c); });
+            REQUIRE(dst == expected);
+        }
+    }
+}
+
+TEST_CASE("transformed_filtered_view") {
+    const auto text = std::string{"Room 101, Floor 3: CONFERENCE Hall"};
+    auto view = fsv::transformed_filtered_view{fsv::filtered_string_view{text, no_digits}, fsv::char_map::to_lower()};
+
+    REQUIRE(static_cast<std::string>(view) == "room , floor : conference hall");
+    REQUIRE(view.size() == 30);
+    REQUIRE(*view.begin() == 'r');
+    REQUIRE(*view.rbegin() == 'l');
+    REQUIRE(*view.begin().base() == 'R');
+    REQUIRE(std::string(view.rbegin(), view.rend()) == "llah ecnerefnoc : roolf , moor");
+
+    auto oss = std::ostringstream{};
+    oss << view;
+    REQUIRE(oss.str() == "room , floor : conference hall");
+
+    SECTION("comparison sees mapped characters") {
+        REQUIRE(view == fsv::filtered_string_view{"room , floor : conference hall"});
+        REQUIRE(fsv::filtered_string_view{"room , floor : conference hall"} == view);
+        REQUIRE(view > fsv::filtered_string_view{"Room , floor : conference hall"});
+        auto other = fsv::transformed_filtered_view{fsv::filtered_string_view{"ROOM 2"}, fsv::char_map::to_lower()};
+        REQUIRE(other > view);
+        REQUIRE_FALSE(other == view);
+    }
+
+    SECTION("hashes like the string it produces") {
+        REQUIRE(fsv::hash{}(view) == fsv::hash{}(std::string{"room , floor : conference hall"}));
+        REQUIRE(std::hash<fsv::transformed_filtered_view>{}(view) == fsv::hash{}(static_cast<std::string>(view)));
+
+        auto keywords = std::unordered_set<std::string, fsv::hash, fsv::equal_to>{"select", "from"};
+        auto word = fsv::transformed_filtered_view{fsv::filtered_string_view{"SeLeCt"}, fsv::char_map::to_lower()};
+        REQUIRE(keywords.find(word) != keywords.end());
+    }
+
+    SECTION("long runs through the staging buffer") {
+        auto long_text = std::string{};
+        for (auto i = 0; i < 100; ++i) {
+            long_text += "MiXeD 42 CaSe ";
+        }
+        auto upper = fsv::transformed_filtered_view{fsv::filtered_string_view{long_text, no_digits},
+                                                    fsv::char_map::to_upper()};
+        auto expected = std::string{};
+        for (auto c : long_text) {
+            if (no_digits(c)) {
+                expected += static_cast<char>(std::toupper(c));
+            }
+        }
+        REQUIRE(static_cast<std::string>(upper) == expected);
+        REQUIRE(fsv::hash{}(upper) == fsv::hash{}(expected));
+    }
+}
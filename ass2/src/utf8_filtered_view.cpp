@@ -0,0 +1,235 @@
+#include "./utf8_filtered_view.h"
+#include "./instrument.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace fsv {
+    namespace {
+        constexpr std::size_t block_size = 32;
+        constexpr auto replacement_bytes = std::string_view{"\xEF\xBF\xBD"};
+
+        // whether the block_size bytes at p are all ASCII
+        auto ascii_block(const char* p) noexcept -> bool {
+#ifdef __SSE2__
+            const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+            return _mm_movemask_epi8(_mm_or_si128(lo, hi)) == 0;
+#else
+            std::uint64_t words[block_size / 8];
+            std::memcpy(words, p, block_size);
+            return ((words[0] | words[1] | words[2] | words[3]) & 0x8080808080808080U) == 0;
+#endif
+        }
+
+        struct decoded {
+            char32_t cp;
+            std::size_t len;
+            bool valid;
+        };
+
+        // decodes the code point at p < last; a malformed sequence decodes as one byte of U+FFFD
+        auto decode(const char* p, const char* last) noexcept -> decoded {
+            const auto lead = static_cast<unsigned char>(*p);
+            if (lead < 0x80) {
+                return {lead, 1, true};
+            }
+            constexpr auto bad = decoded{utf8_filtered_view::replacement, 1, false};
+            std::size_t len = 0;
+            char32_t cp = 0;
+            char32_t min = 0;
+            if (lead >= 0xC2 && lead <= 0xDF) {
+                len = 2;
+                cp = lead & 0x1FU;
+                min = 0x80;
+            }
+            else if (lead >= 0xE0 && lead <= 0xEF) {
+                len = 3;
+                cp = lead & 0x0FU;
+                min = 0x800;
+            }
+            else if (lead >= 0xF0 && lead <= 0xF4) {
+                len = 4;
+                cp = lead & 0x07U;
+                min = 0x10000;
+            }
+            else {
+                return bad;
+            }
+            if (static_cast<std::size_t>(last - p) < len) {
+                return bad;
+            }
+            for (std::size_t i = 1; i < len; ++i) {
+                const auto byte = static_cast<unsigned char>(p[i]);
+                if ((byte & 0xC0U) != 0x80U) {
+                    return bad;
+                }
+                cp = (cp << 6) | (byte & 0x3FU);
+            }
+            if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+                return bad;
+            }
+            return {cp, len, true};
+        }
+    } // namespace
+
+    code_point_filter utf8_filtered_view::default_predicate = [](char32_t) { return true; };
+
+    utf8_filtered_view::utf8_filtered_view() noexcept
+    : ptr_(nullptr)
+    , length_(0)
+    , pred_(default_predicate)
+    , ascii_()
+    , all_ascii_pass_(true)
+    , no_ascii_pass_(false) {
+        ascii_.fill(true);
+    }
+
+    utf8_filtered_view::utf8_filtered_view(const std::string& str)
+    : utf8_filtered_view(str.data(), str.size(), default_predicate) {}
+
+    utf8_filtered_view::utf8_filtered_view(const std::string& str, code_point_filter predicate)
+    : utf8_filtered_view(str.data(), str.size(), std::move(predicate)) {}
+
+    utf8_filtered_view::utf8_filtered_view(const char* str)
+    : utf8_filtered_view(str, std::strlen(str), default_predicate) {}
+
+    utf8_filtered_view::utf8_filtered_view(const char* str, code_point_filter predicate)
+    : utf8_filtered_view(str, std::strlen(str), std::move(predicate)) {}
+
+    utf8_filtered_view::utf8_filtered_view(const char* str, std::size_t len, code_point_filter predicate)
+    : ptr_(str)
+    , length_(len)
+    , pred_(std::move(predicate))
+    , ascii_()
+    , all_ascii_pass_(true)
+    , no_ascii_pass_(true) {
+        for (std::size_t c = 0; c < ascii_.size(); ++c) {
+            ascii_[c] = instrument::call(pred_, static_cast<char32_t>(c));
+            all_ascii_pass_ = all_ascii_pass_ && ascii_[c];
+            no_ascii_pass_ = no_ascii_pass_ && !ascii_[c];
+        }
+    }
+
+    template<typename F>
+    auto utf8_filtered_view::for_each_run(F&& visit) const -> void {
+        const char* last = ptr_ + length_;
+        const char* run = ptr_;
+        std::size_t run_code_points = 0;
+        auto flush = [&](const char* p) {
+            if (p != run) {
+                visit(run, static_cast<std::size_t>(p - run), run_code_points);
+            }
+            run_code_points = 0;
+        };
+        for (const char* p = ptr_; p != last;) {
+            if (static_cast<std::size_t>(last - p) >= block_size && ascii_block(p)) {
+                if (all_ascii_pass_) {
+                    run_code_points += block_size;
+                }
+                else {
+                    for (const char* q = p; q != p + block_size; ++q) {
+                        if (ascii_[static_cast<unsigned char>(*q)]) {
+                            ++run_code_points;
+                        }
+                        else {
+                            flush(q);
+                            run = q + 1;
+                        }
+                    }
+                }
+                p += block_size;
+                continue;
+            }
+            const auto [cp, len, valid] = decode(p, last);
+            const auto pass = cp < 0x80 ? ascii_[cp] : instrument::call(pred_, cp);
+            if (pass && valid) {
+                ++run_code_points;
+            }
+            else {
+                flush(p);
+                if (pass) {
+                    visit(replacement_bytes.data(), replacement_bytes.size(), std::size_t{1});
+                }
+                run = p + len;
+            }
+            p += len;
+        }
+        flush(last);
+    }
+
+    auto utf8_filtered_view::next_match(const char* from) const -> iter {
+        const char* last = ptr_ + length_;
+        auto it = iter{};
+        it.owner_ = this;
+        for (const char* p = from; p != last;) {
+            if (no_ascii_pass_ && static_cast<std::size_t>(last - p) >= block_size && ascii_block(p)) {
+                p += block_size;
+                continue;
+            }
+            const auto [cp, len, valid] = decode(p, last);
+            if (cp < 0x80 ? ascii_[cp] : instrument::call(pred_, cp)) {
+                it.cur_ = p;
+                it.len_ = len;
+                it.cp_ = cp;
+                return it;
+            }
+            p += len;
+        }
+        it.cur_ = last;
+        return it;
+    }
+
+    utf8_filtered_view::operator std::string() const {
+        FSV_INSTRUMENT_COUNT(materializations, 1);
+        auto result = std::string{};
+        for_each_run([&result](const char* first, std::size_t bytes, std::size_t) { result.append(first, bytes); });
+        return result;
+    }
+
+    auto utf8_filtered_view::size() const -> std::size_t {
+        std::size_t count = 0;
+        for_each_run([&count](const char*, std::size_t, std::size_t code_points) { count += code_points; });
+        return count;
+    }
+
+    auto utf8_filtered_view::empty() const -> bool {
+        return begin() == end();
+    }
+
+    auto utf8_filtered_view::data() const noexcept -> const char* {
+        return ptr_;
+    }
+
+    auto utf8_filtered_view::predicate() const noexcept -> const code_point_filter& {
+        return pred_;
+    }
+
+    auto utf8_filtered_view::begin() const -> const_iterator {
+        return next_match(ptr_);
+    }
+
+    auto utf8_filtered_view::end() const -> const_iterator {
+        auto it = iter{};
+        it.owner_ = this;
+        it.cur_ = ptr_ + length_;
+        return it;
+    }
+
+    auto operator==(const utf8_filtered_view& lhs, const utf8_filtered_view& rhs) -> bool {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    auto operator<<(std::ostream& os, const utf8_filtered_view& view) -> std::ostream& {
+        view.for_each_run([&os](const char* first, std::size_t bytes, std::size_t) {
+            os.write(first, static_cast<std::streamsize>(bytes));
+        });
+        return os;
+    }
+} // namespace fsv
@@ -0,0 +1,112 @@
+#ifndef COMP6771_ASS2_UTF8_FILTERED_VIEW_H
+#define COMP6771_ASS2_UTF8_FILTERED_VIEW_H
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ostream>
+#include <string>
+
+namespace fsv {
+    using code_point_filter = std::function<bool(char32_t)>;
+
+    // A filtered view over UTF-8 text that steps by code point and filters with a char32_t
+    // predicate. Malformed sequences (bad lead or continuation bytes, overlong forms, surrogates,
+    // values past U+10FFFF, truncation) are read one byte at a time as U+FFFD.
+    //
+    // The predicate is assumed to be pure: it is evaluated once per ASCII character at construction
+    // into a table, and blocks of 32 ASCII bytes are then filtered from that table without calling it.
+    class utf8_filtered_view {
+        class iter {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = char32_t;
+            using reference = char32_t;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+
+            iter() = default;
+
+            auto operator*() const -> reference {
+                return cp_;
+            }
+
+            auto operator++() -> iter& {
+                *this = owner_->next_match(cur_ + len_);
+                return *this;
+            }
+            auto operator++(int) -> iter {
+                auto old = *this;
+                ++*this;
+                return old;
+            }
+
+            // the encoded code point in the underlying text
+            [[nodiscard]] auto base() const noexcept -> const char* {
+                return cur_;
+            }
+            [[nodiscard]] auto encoded_size() const noexcept -> std::size_t {
+                return len_;
+            }
+
+            friend auto operator==(const iter& lhs, const iter& rhs) -> bool {
+                return lhs.cur_ == rhs.cur_;
+            }
+
+        private:
+            const utf8_filtered_view* owner_ = nullptr;
+            const char* cur_ = nullptr;
+            std::size_t len_ = 0;
+            char32_t cp_ = 0;
+
+            friend class utf8_filtered_view;
+        };
+
+    public:
+        static constexpr char32_t replacement = U'\uFFFD';
+        static code_point_filter default_predicate;
+
+        utf8_filtered_view() noexcept;
+        utf8_filtered_view(const std::string& str);
+        utf8_filtered_view(const std::string& str, code_point_filter predicate);
+        utf8_filtered_view(const char* str);
+        utf8_filtered_view(const char* str, code_point_filter predicate);
+        utf8_filtered_view(const char* str, std::size_t len, code_point_filter predicate);
+
+        // the passing code points, re-encoded; U+FFFD is written as EF BF BD
+        explicit operator std::string() const;
+
+        // number of code points that pass
+        [[nodiscard]] auto size() const -> std::size_t;
+        [[nodiscard]] auto empty() const -> bool;
+        [[nodiscard]] auto data() const noexcept -> const char*;
+        [[nodiscard]] auto predicate() const noexcept -> const code_point_filter&;
+
+        using iterator = iter;
+        using const_iterator = iter;
+
+        [[nodiscard]] auto begin() const -> const_iterator;
+        [[nodiscard]] auto end() const -> const_iterator;
+
+        friend auto operator==(const utf8_filtered_view& lhs, const utf8_filtered_view& rhs) -> bool;
+        friend auto operator<<(std::ostream& os, const utf8_filtered_view& view) -> std::ostream&;
+
+    private:
+        // calls visit(first, bytes, code_points) on each maximal run of passing, well-formed code
+        // points, which can be copied verbatim, and on the encoding of U+FFFD for each passing
+        // malformed sequence
+        template<typename F>
+        auto for_each_run(F&& visit) const -> void;
+        auto next_match(const char* from) const -> iter;
+
+        const char* ptr_;
+        std::size_t length_;
+        code_point_filter pred_;
+        std::array<bool, 128> ascii_;
+        bool all_ascii_pass_;
+        bool no_ascii_pass_;
+    };
+} // namespace fsv
+
+#endif // COMP6771_ASS2_UTF8_FILTERED_VIEW_H
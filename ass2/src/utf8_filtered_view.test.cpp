@@ -0,0 +1,90 @@
+#include "./utf8_filtered_view.h"
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    auto const not_punct = [](char32_t cp) {
+        return !(cp == U'!' || cp == U',' || cp == U'¡' || cp == U'¿' || cp == U'?' || cp == U'—' || cp == U'…');
+    };
+
+    auto code_points(const fsv::utf8_filtered_view& view) -> std::vector<char32_t> {
+        return {view.begin(), view.end()};
+    }
+} // namespace
+
+TEST_CASE("utf8_filtered_view steps by code point") {
+    const auto text = std::string{"¡Hola, señor! — ¿Qué tal…?"};
+    auto view = fsv::utf8_filtered_view{text, not_punct};
+    REQUIRE(static_cast<std::string>(view) == "Hola señor  Qué tal");
+    REQUIRE(view.size() == 19);
+    REQUIRE_FALSE(view.empty());
+    REQUIRE(view.data() == text.data());
+
+    auto it = view.begin();
+    std::advance(it, 7);
+    REQUIRE(*it == U'ñ');
+    REQUIRE(it.encoded_size() == 2);
+    REQUIRE(it.base() == text.data() + text.find("ñ"));
+
+    auto oss = std::ostringstream{};
+    oss << view;
+    REQUIRE(oss.str() == "Hola señor  Qué tal");
+}
+
+TEST_CASE("utf8_filtered_view default predicate") {
+    auto view = fsv::utf8_filtered_view{"a€😀"};
+    REQUIRE(code_points(view) == std::vector<char32_t>{U'a', U'€', U'😀'});
+    REQUIRE(static_cast<std::string>(view) == "a€😀");
+    REQUIRE(fsv::utf8_filtered_view{}.empty());
+    REQUIRE(fsv::utf8_filtered_view{""}.size() == 0);
+}
+
+TEST_CASE("malformed sequences read as U+FFFD") {
+    const auto r = fsv::utf8_filtered_view::replacement;
+    // stray continuation, overlong '/', surrogate, past U+10FFFF, truncated at the end
+    const auto text = std::string{"a\x80" "b\xC0\xAF" "c\xED\xA0\x80" "d\xF4\x90\x80\x80" "e\xE2\x82"};
+    auto view = fsv::utf8_filtered_view{text};
+    const auto expected = std::vector<char32_t>{U'a', r, U'b', r, r, U'c', r, r, r, U'd', r, r, r, r, U'e', r, r};
+    REQUIRE(code_points(view) == expected);
+    REQUIRE(view.size() == expected.size());
+    REQUIRE(static_cast<std::string>(fsv::utf8_filtered_view{"x\xFFy"}) == "x\xEF\xBF\xBDy");
+
+    auto no_replacement = fsv::utf8_filtered_view{text, [r](char32_t cp) { return cp != r; }};
+    REQUIRE(static_cast<std::string>(no_replacement) == "abcde");
+}
+
+TEST_CASE("ASCII blocks agree with code point stepping") {
+    auto text = std::string{};
+    for (auto i = 0; i < 20; ++i) {
+        text += "plain ASCII text, long enough to fill whole blocks. ";
+        text += i % 3 == 0 ? "née " : "";
+    }
+    auto is_vowel = [](char32_t cp) {
+        return std::u32string_view{U"aeiouAEIOUé"}.find(cp) != std::u32string_view::npos;
+    };
+    auto no_vowels = [&is_vowel](char32_t cp) { return !is_vowel(cp); };
+    auto non_ascii = [](char32_t cp) { return cp >= 0x80; };
+
+    for (const auto& pred : std::vector<fsv::code_point_filter>{is_vowel, no_vowels, non_ascii,
+                                                               fsv::utf8_filtered_view::default_predicate}) {
+        auto view = fsv::utf8_filtered_view{text, pred};
+        auto expected = std::string{};
+        auto count = std::size_t{0};
+        for (auto it = view.begin(); it != view.end(); ++it) {
+            expected.append(it.base(), it.encoded_size());
+            ++count;
+        }
+        REQUIRE(static_cast<std::string>(view) == expected);
+        REQUIRE(view.size() == count);
+    }
+    REQUIRE(fsv::utf8_filtered_view{text, non_ascii}.size() == 7);
+}
+
+TEST_CASE("utf8_filtered_view equality") {
+    auto lhs = fsv::utf8_filtered_view{"café!", not_punct};
+    REQUIRE(lhs == fsv::utf8_filtered_view{"café"});
+    REQUIRE_FALSE(lhs == fsv::utf8_filtered_view{"cafe"});
+}
@@ -1,12 +1,22 @@
 #ifndef GDWG_GRAPH_H
 #define GDWG_GRAPH_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <vector>
 
 // TODO: Make both graph and edge generic
@@ -100,47 +110,199 @@ namespace gdwg {
 		N dst_;
 	};
 
-	template<typename N, typename E>
-	struct EdgeComparator {
-		bool operator()(const std::unique_ptr<Edge<N, E>>& lhs, const std::unique_ptr<Edge<N, E>>& rhs) const {
-			auto [lhs_src, lhs_dst] = lhs->get_nodes();
-			auto [rhs_src, rhs_dst] = rhs->get_nodes();
-			if (lhs_src != rhs_src)
-				return lhs_src < rhs_src;
-			if (lhs_dst != rhs_dst)
-				return lhs_dst < rhs_dst;
-			return lhs->get_weight() < rhs->get_weight();
-		}
-	};
-
 	template<typename N, typename E>
 	class Graph {
+		// Each node value is stored once, as a key of nodes_, and edges refer to it by a 32-bit id.
+		using node_id = std::uint32_t;
+
+		// An edge as stored: the source is the node owning the list, so only the destination is kept.
+		struct OutEdge {
+			node_id dst;
+			std::optional<E> weight;
+
+			friend auto operator==(OutEdge const&, OutEdge const&) -> bool = default;
+		};
+
+		// orders edges by id rather than by value, which needs no lookups in the node table
+		struct IdLess {
+			auto operator()(OutEdge const& lhs, OutEdge const& rhs) const -> bool {
+				return std::tie(lhs.dst, lhs.weight) < std::tie(rhs.dst, rhs.weight);
+			}
+		};
+
+		// A node's outgoing edges are a contiguous array sorted by destination value, then weight
+		// (unweighted first), so walking nodes_ in order visits every edge in (src, dst, weight) order.
+		// in holds the ids of the nodes with at least one edge into this one, sorted by id, so that
+		// changes to a node only visit the out lists that actually refer to it.
+		//
+		// Inserting into the middle of a long array costs a shift of everything after it, so once a
+		// list has defer_limit entries, out-of-order additions wait in deferred_out and deferred_in
+		// instead. settle() merges them in before the lists are next read or changed. Const members
+		// call it too, so it locks the table while merging: concurrent const calls stay race-free, as
+		// they are on a standard container.
+		struct Node {
+			node_id id;
+			std::vector<OutEdge> out;
+			std::vector<node_id> in;
+			std::set<OutEdge, IdLess> deferred_out;
+			std::vector<node_id> deferred_in;
+		};
+
+		static constexpr std::size_t defer_limit = 64;
+
+		// id -> element of nodes_; released ids are reused before new ones.
+		// It lives on the heap so that iterators keep a valid pointer to it across moves.
+		struct NodeTable {
+			std::vector<std::pair<N const, Node>*> entries;
+			std::vector<node_id> free;
+			std::vector<node_id> unsettled; // nodes with deferred edges or in-links
+			std::atomic<bool> dirty = false; // whether unsettled is non-empty; cleared under settling
+			std::mutex settling;
+
+			NodeTable() = default;
+			// only settled tables are copied, so there is nothing deferred to carry over
+			NodeTable(NodeTable const& other)
+			: entries(other.entries)
+			, free(other.free) {}
+
+			[[nodiscard]] auto value(node_id id) const -> N const& {
+				return entries[id]->first;
+			}
+			[[nodiscard]] auto node(node_id id) const -> Node& {
+				return entries[id]->second;
+			}
+			[[nodiscard]] auto less(node_id lhs, node_id rhs) const -> bool {
+				return value(lhs) < value(rhs);
+			}
+		};
+
+		using node_iterator = typename std::map<N, Node>::const_iterator;
+
 	 public:
+		// Edges are plain records, so dereferencing creates the Edge object the caller asked for.
+		class iterator {
+		 public:
+			using iterator_category = std::bidirectional_iterator_tag;
+			using value_type = std::unique_ptr<Edge<N, E>>;
+			using reference = value_type;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				auto const& [src, node] = *node_;
+				auto const& edge = node.out[index_];
+				if (edge.weight.has_value()) {
+					return std::make_unique<WeightedEdge<N, E>>(src, table_->value(edge.dst), *edge.weight);
+				}
+				return std::make_unique<UnweightedEdge<N, E>>(src, table_->value(edge.dst));
+			}
+
+			auto operator++() -> iterator& {
+				++index_;
+				skip_empty();
+				return *this;
+			}
+			auto operator++(int) -> iterator {
+				auto old = *this;
+				++*this;
+				return old;
+			}
+			auto operator--() -> iterator& {
+				while (index_ == 0) {
+					--node_;
+					index_ = node_->second.out.size();
+				}
+				--index_;
+				return *this;
+			}
+			auto operator--(int) -> iterator {
+				auto old = *this;
+				--*this;
+				return old;
+			}
+
+			friend auto operator==(iterator const& lhs, iterator const& rhs) -> bool {
+				return lhs.node_ == rhs.node_ && lhs.index_ == rhs.index_;
+			}
+
+		 private:
+			iterator(NodeTable const* table, node_iterator node, node_iterator last, std::size_t index)
+			: table_(table)
+			, node_(node)
+			, last_(last)
+			, index_(index) {
+				skip_empty();
+			}
+
+			// moves past nodes without (further) outgoing edges, so every valid iterator names an edge
+			auto skip_empty() -> void {
+				while (node_ != last_ && index_ == node_->second.out.size()) {
+					++node_;
+					index_ = 0;
+				}
+			}
+
+			NodeTable const* table_ = nullptr;
+			node_iterator node_;
+			node_iterator last_;
+			std::size_t index_ = 0;
+
+			friend class Graph;
+		};
+		using const_iterator = iterator;
+
 		Graph() = default;
 
 		Graph(std::initializer_list<N> il) {
 			for (auto const& node : il) {
-				nodes_.insert(node);
+				insert_node(node);
 			}
 		}
 
 		template<typename InputIt>
 		Graph(InputIt first, InputIt last) {
 			for (auto it = first; it != last; ++it) {
-				nodes_.insert(*it);
+				insert_node(*it);
 			}
 		}
 
-		Graph(Graph const& other) = default;
+		// edges hold ids, so the copy only needs its own table pointing at its own nodes
+		Graph(Graph const& other)
+		: nodes_(other.settled_nodes()) {
+			if (other.table_ == nullptr) {
+				return;
+			}
+			table_ = std::make_unique<NodeTable>(*other.table_);
+			for (auto& entry : nodes_) {
+				table_->entries[entry.second.id] = &entry;
+			}
+		}
 
 		Graph(Graph&& other) noexcept = default;
 
-		auto operator=(Graph const& other) -> Graph& = default;
+		auto operator=(Graph const& other) -> Graph& {
+			if (this != &other) {
+				*this = Graph(other);
+			}
+			return *this;
+		}
 
 		auto operator=(Graph&& other) noexcept -> Graph& = default;
 
 		auto insert_node(N const& value) -> bool {
-			return nodes_.insert(value).second;
+			auto [it, inserted] = nodes_.try_emplace(value, Node{});
+			if (inserted) {
+				// a node that can't be given an id is not kept
+				try {
+					it->second.id = intern(*it);
+				} catch (...) {
+					nodes_.erase(it);
+					throw;
+				}
+			}
+			return inserted;
 		}
 		auto insert_edge(N const& src, N const& dst, std::optional<E> weight = std::nullopt) -> bool;
 		auto replace_node(N const& old_data, N const& new_data) -> bool;
@@ -156,109 +318,100 @@ namespace gdwg {
 			return nodes_.empty();
 		}
 		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
-			if (!is_node(src) || !is_node(dst)) {
+			auto const src_it = nodes_.find(src);
+			auto const dst_it = nodes_.find(dst);
+			if (src_it == nodes_.end() || dst_it == nodes_.end()) {
 				throw std::runtime_error("Cannot call gdwg::Graph<N, E>::is_connected if src or dst node don't exist "
 				                         "in the graph");
 			}
+			settle();
 
-			for (auto const& edge : edges_) {
-				auto [e_src, e_dst] = edge->get_nodes();
-				if (e_src == src && e_dst == dst) {
-					return true;
-				}
-			}
-			return false;
+			auto [first, last] = dst_range(src_it->second.out, dst);
+			return first != last;
 		}
 		[[nodiscard]] auto nodes() const -> std::vector<N> {
-			return std::vector<N>(nodes_.begin(), nodes_.end());
+			std::vector<N> result;
+			result.reserve(nodes_.size());
+			for (auto const& [value, node] : nodes_) {
+				result.push_back(value);
+			}
+			return result;
 		}
 		[[nodiscard]] auto edges(N const& src, N const& dst) const -> std::vector<std::unique_ptr<Edge<N, E>>> {
-			if (!is_node(src) || !is_node(dst)) {
+			auto const src_it = nodes_.find(src);
+			auto const dst_it = nodes_.find(dst);
+			if (src_it == nodes_.end() || dst_it == nodes_.end()) {
 				throw std::runtime_error("Cannot call gdwg::Graph<N, E>::edges if src or dst node don't exist in the "
 				                         "graph");
 			}
+			settle();
 
 			std::vector<std::unique_ptr<Edge<N, E>>> result;
 
-			for (auto const& edge : edges_) {
-				auto [e_src, e_dst] = edge->get_nodes();
-				if (e_src == src && e_dst == dst) {
-					if (edge->is_weighted()) {
-						result.push_back(std::make_unique<WeightedEdge<N, E>>(e_src, e_dst, edge->get_weight().value()));
-					}
-					else {
-						result.push_back(std::make_unique<UnweightedEdge<N, E>>(e_src, e_dst));
-					}
+			auto [first, last] = dst_range(src_it->second.out, dst);
+			for (auto it = first; it != last; ++it) {
+				if (it->weight.has_value()) {
+					result.push_back(std::make_unique<WeightedEdge<N, E>>(src, dst, *it->weight));
+				}
+				else {
+					result.push_back(std::make_unique<UnweightedEdge<N, E>>(src, dst));
 				}
 			}
 
 			return result;
 		}
 		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
-			if (!is_node(src)) {
+			auto const src_it = nodes_.find(src);
+			if (src_it == nodes_.end()) {
 				throw std::runtime_error("Cannot call gdwg::Graph<N, E>::connections if src doesn't exist in the "
 				                         "graph");
 			}
-			std::set<N> unique_dsts;
-
-			for (auto const& edge : edges_) {
-				auto [e_src, e_dst] = edge->get_nodes();
-				if (e_src == src) {
-					unique_dsts.insert(e_dst);
+			settle();
+			// edges out of src are sorted by destination, so duplicates are adjacent
+			std::vector<N> result;
+			auto last_dst = std::optional<node_id>{};
+			for (auto const& edge : src_it->second.out) {
+				if (last_dst != edge.dst) {
+					last_dst = edge.dst;
+					result.push_back(table_->value(edge.dst));
 				}
 			}
-			return std::vector<N>(unique_dsts.begin(), unique_dsts.end());
+			return result;
 		}
 		[[nodiscard]] auto operator==(Graph const& other) const -> bool {
-			// node part
-			if (this->nodes_ != other.nodes_) {
-				return false;
-			}
-
-			// compare edge numbers
-			if (this->edges_.size() != other.edges_.size()) {
-				return false;
-			}
-
-			// edge part
-			auto it1 = this->edges_.begin();
-			auto it2 = other.edges_.begin();
-
-			while (it1 != this->edges_.end()) {
-				auto const& edge1 = *it1;
-				auto const& edge2 = *it2;
-
-				if (!(*edge1 == *edge2)) {
-					return false;
-				}
-
-				++it1;
-				++it2;
-			}
-
-			return true;
+			settle();
+			other.settle();
+			// compared by value only: the two graphs may have interned their nodes under different ids
+			auto const same_edge = [this, &other](OutEdge const& lhs, OutEdge const& rhs) {
+				return lhs.weight == rhs.weight && table_->value(lhs.dst) == other.table_->value(rhs.dst);
+			};
+			return std::equal(nodes_.begin(),
+			                  nodes_.end(),
+			                  other.nodes_.begin(),
+			                  other.nodes_.end(),
+			                  [&same_edge](auto const& lhs, auto const& rhs) {
+				                  return lhs.first == rhs.first
+				                         && std::equal(lhs.second.out.begin(),
+				                                       lhs.second.out.end(),
+				                                       rhs.second.out.begin(),
+				                                       rhs.second.out.end(),
+				                                       same_edge);
+			                  });
 		}
 
 		void print_nodes() const {
-			for (const auto& node : nodes_) {
+			for (const auto& [node, data] : nodes_) {
 				std::cout << node << "\n";
 			}
 		}
-		using iterator = typename std::set<std::unique_ptr<Edge<N, E>>, EdgeComparator<N, E>>::iterator;
-		using const_iterator = typename std::set<std::unique_ptr<Edge<N, E>>, EdgeComparator<N, E>>::const_iterator;
 		auto erase_edge(iterator i) -> iterator;
-		[[nodiscard]] auto begin() -> iterator {
-			return edges_.begin();
-		}
-		[[nodiscard]] auto end() -> iterator {
-			return edges_.end();
-		}
-
 		[[nodiscard]] auto begin() const -> const_iterator {
-			return edges_.begin();
+			settle();
+			return iterator{table_.get(), nodes_.begin(), nodes_.end(), 0};
 		}
 		[[nodiscard]] auto end() const -> const_iterator {
-			return edges_.end();
+			settle();
+			return iterator{table_.get(), nodes_.end(), nodes_.end(), 0};
 		}
 		auto erase_edge(iterator i, iterator s) -> iterator;
 		auto clear() noexcept -> void;
@@ -267,49 +420,239 @@ namespace gdwg {
 
 		[[nodiscard]] auto find(N const& src, N const& dst, std::optional<E> weight = std::nullopt) const
 		    -> const_iterator {
-			for (auto it = edges_.begin(); it != edges_.end(); ++it) {
-				auto const& edge = *it;
-				auto [e_src, e_dst] = edge->get_nodes();
-
-				if (e_src == src && e_dst == dst) {
-					if (!weight.has_value() && !edge->is_weighted()) {
-						return it;
-					}
-					if (weight.has_value() && edge->is_weighted() && edge->get_weight() == weight) {
-						return it;
-					}
-				}
+			auto const src_it = nodes_.find(src);
+			auto const dst_it = nodes_.find(dst);
+			if (src_it == nodes_.end() || dst_it == nodes_.end()) {
+				return end();
+			}
+			settle();
+			auto const& out = src_it->second.out;
+			auto const key = OutEdge{dst_it->second.id, std::move(weight)};
+			auto const it = std::lower_bound(out.begin(), out.end(), key, edge_less());
+			if (it == out.end() || *it != key) {
+				return end();
 			}
-			return edges_.end();
+			return iterator{table_.get(), src_it, nodes_.end(), static_cast<std::size_t>(it - out.begin())};
 		}
 
 	 private:
-		std::set<N> nodes_;
-		std::set<std::unique_ptr<Edge<N, E>>, EdgeComparator<N, E>> edges_;
+		// gives a new element of nodes_ an id; the table is created on first use, so a
+		// default-constructed or moved-from graph owns none
+		auto intern(std::pair<N const, Node>& entry) -> node_id {
+			if (table_ == nullptr) {
+				table_ = std::make_unique<NodeTable>();
+			}
+			if (!table_->free.empty()) {
+				auto const id = table_->free.back();
+				table_->free.pop_back();
+				table_->entries[id] = &entry;
+				return id;
+			}
+			// every id is in use, so the next one would wrap around onto an existing node
+			if (table_->entries.size() > std::numeric_limits<node_id>::max()) {
+				throw std::runtime_error("Cannot call gdwg::Graph<N, E>::insert_node when the graph already has 2^32 "
+				                         "nodes");
+			}
+			auto const id = static_cast<node_id>(table_->entries.size());
+			table_->entries.push_back(&entry);
+			return id;
+		}
+		auto release(node_id id) -> void {
+			table_->entries[id] = nullptr;
+			table_->free.push_back(id);
+		}
+
+		// records that src has an edge into dst; a no-op if it already had one
+		static auto link(node_id src, Node& dst) -> void {
+			auto const pos = std::lower_bound(dst.in.begin(), dst.in.end(), src);
+			if (pos == dst.in.end() || *pos != src) {
+				dst.in.insert(pos, src);
+			}
+		}
+		static auto unlink(node_id src, Node& dst) -> void {
+			auto const pos = std::lower_bound(dst.in.begin(), dst.in.end(), src);
+			if (pos != dst.in.end() && *pos == src) {
+				dst.in.erase(pos);
+			}
+		}
+
+		// called after deferring an edge or in-link of node, so that settle() visits the node once
+		auto defer(Node const& node) const -> void {
+			if (node.deferred_out.size() + node.deferred_in.size() == 1) {
+				table_->unsettled.push_back(node.id);
+				table_->dirty.store(true, std::memory_order_relaxed);
+			}
+		}
+		// merges every deferred edge and in-link into the sorted lists
+		auto settle() const -> void {
+			if (table_ == nullptr || !table_->dirty.load(std::memory_order_acquire)) {
+				return;
+			}
+			auto const lock = std::scoped_lock{table_->settling};
+			if (!table_->dirty.load(std::memory_order_relaxed)) {
+				return;
+			}
+			auto const less = edge_less();
+			for (auto const id : table_->unsettled) {
+				auto& node = table_->node(id);
+				auto const sorted_out = static_cast<std::ptrdiff_t>(node.out.size());
+				while (!node.deferred_out.empty()) {
+					node.out.push_back(std::move(node.deferred_out.extract(node.deferred_out.begin()).value()));
+				}
+				std::sort(node.out.begin() + sorted_out, node.out.end(), less);
+				std::inplace_merge(node.out.begin(), node.out.begin() + sorted_out, node.out.end(), less);
+
+				auto const sorted_in = static_cast<std::ptrdiff_t>(node.in.size());
+				node.in.insert(node.in.end(), node.deferred_in.begin(), node.deferred_in.end());
+				node.deferred_in.clear();
+				std::sort(node.in.begin() + sorted_in, node.in.end());
+				std::inplace_merge(node.in.begin(), node.in.begin() + sorted_in, node.in.end());
+			}
+			table_->unsettled.clear();
+			table_->dirty.store(false, std::memory_order_release);
+		}
+		// nodes_ with nothing deferred, so that copying it can't overlap a merge by another reader
+		[[nodiscard]] auto settled_nodes() const -> std::map<N, Node> const& {
+			settle();
+			return nodes_;
+		}
+
+		[[nodiscard]] auto edge_less() const {
+			return [table = table_.get()](OutEdge const& lhs, OutEdge const& rhs) {
+				if (lhs.dst != rhs.dst) {
+					return table->less(lhs.dst, rhs.dst);
+				}
+				return lhs.weight < rhs.weight;
+			};
+		}
+		// the edges of out going to dst
+		[[nodiscard]] auto dst_range(std::vector<OutEdge> const& out, N const& dst) const {
+			return std::ranges::equal_range(out, dst, std::less<>{}, [this](OutEdge const& edge) -> N const& {
+				return table_->value(edge.dst);
+			});
+		}
+		// Moves out[first, last), the edges to one destination, to where the edges to `value` belong,
+		// points them at id, and merges them with the edges already there, dropping duplicates. Only the
+		// elements between the two places are shifted.
+		auto move_run(std::vector<OutEdge>& out, std::size_t first, std::size_t last, N const& value, node_id id) const
+		    -> void {
+			if (first == last) {
+				return;
+			}
+			auto const by_value = [this](OutEdge const& edge) -> N const& { return table_->value(edge.dst); };
+			auto run_first = out.begin() + static_cast<std::ptrdiff_t>(first);
+			auto run_last = out.begin() + static_cast<std::ptrdiff_t>(last);
+			if (first != 0 && !(by_value(out[first - 1]) < value)) {
+				auto const pos = std::ranges::lower_bound(out.begin(), run_first, value, std::less<>{}, by_value);
+				run_last = std::rotate(pos, run_first, run_last);
+				run_first = pos;
+			}
+			else {
+				auto const pos = std::ranges::lower_bound(run_last, out.end(), value, std::less<>{}, by_value);
+				run_first = std::rotate(run_first, run_last, pos);
+				run_last = pos;
+			}
+			// the edges already going to value, if any, now follow the run
+			auto const merged_last = std::ranges::upper_bound(run_last, out.end(), value, std::less<>{}, by_value);
+			for (auto it = run_first; it != run_last; ++it) {
+				it->dst = id;
+			}
+			if (merged_last != run_last) {
+				std::inplace_merge(run_first, run_last, merged_last, edge_less());
+				out.erase(std::unique(run_first, merged_last), merged_last);
+			}
+		}
+		auto move_run(std::vector<OutEdge>& out, N const& from, N const& to, node_id id) const -> void {
+			auto const [first, last] = dst_range(out, from);
+			move_run(out,
+			         static_cast<std::size_t>(first - out.cbegin()),
+			         static_cast<std::size_t>(last - out.cbegin()),
+			         to,
+			         id);
+		}
+
+		// erases src.out[first, last), unlinking src from every destination it no longer has an edge to.
+		// Edges to one destination are adjacent, so only the runs at either end can have survivors.
+		auto erase_out(Node& src, std::size_t first, std::size_t last) -> void {
+			auto& out = src.out;
+			auto run = first;
+			for (auto i = first; i != last; ++i) {
+				auto const dst = out[i].dst;
+				if (i + 1 != last && out[i + 1].dst == dst) {
+					continue;
+				}
+				auto const kept = (run == first && first != 0 && out[first - 1].dst == dst)
+				                  || (i + 1 == last && last != out.size() && out[last].dst == dst);
+				if (!kept) {
+					unlink(src.id, table_->node(dst));
+				}
+				run = i + 1;
+			}
+			out.erase(out.begin() + static_cast<std::ptrdiff_t>(first), out.begin() + static_cast<std::ptrdiff_t>(last));
+		}
+
+		std::map<N, Node> nodes_;
+		std::unique_ptr<NodeTable> table_;
 	};
 
 	template<typename N, typename E>
 	auto Graph<N, E>::insert_edge(N const& src, N const& dst, std::optional<E> weight) -> bool {
-		if (!is_node(src) || !is_node(dst)) {
+		auto const src_it = nodes_.find(src);
+		auto const dst_it = nodes_.find(dst);
+		if (src_it == nodes_.end() || dst_it == nodes_.end()) {
 			throw std::runtime_error("Cannot call gdwg::Graph<N, E>::insert_edge when either src or dst node does not "
 			                         "exist");
 		}
 
-		std::unique_ptr<Edge<N, E>> new_edge;
-		if (weight.has_value()) {
-			new_edge = std::make_unique<WeightedEdge<N, E>>(src, dst, weight.value());
+		auto& src_node = src_it->second;
+		auto& dst_node = dst_it->second;
+		auto& out = src_node.out;
+		auto const new_edge = OutEdge{dst_node.id, std::move(weight)};
+		auto const less = edge_less();
+
+		// whether src already had an edge to dst, in which case dst's in list is left alone
+		auto linked = false;
+		// edges loaded in order go on the end without a search
+		if (src_node.deferred_out.empty() && (out.empty() || less(out.back(), new_edge))) {
+			linked = !out.empty() && out.back().dst == new_edge.dst;
+			out.push_back(new_edge);
 		}
 		else {
-			new_edge = std::make_unique<UnweightedEdge<N, E>>(src, dst);
-		}
-
-		for (auto const& e : edges_) {
-			if (*e == *new_edge) {
+			auto const pos = std::lower_bound(out.begin(), out.end(), new_edge, less);
+			if (pos != out.end() && *pos == new_edge) {
 				return false;
 			}
+			linked = (pos != out.end() && pos->dst == new_edge.dst)
+			         || (pos != out.begin() && std::prev(pos)->dst == new_edge.dst);
+			if (src_node.deferred_out.empty() && out.size() < defer_limit) {
+				out.insert(pos, new_edge);
+			}
+			else {
+				auto& deferred = src_node.deferred_out;
+				auto const [it, inserted] = deferred.insert(new_edge);
+				if (!inserted) {
+					return false;
+				}
+				linked = linked || (it != deferred.begin() && std::prev(it)->dst == new_edge.dst)
+				         || (std::next(it) != deferred.end() && std::next(it)->dst == new_edge.dst);
+				defer(src_node);
+			}
 		}
 
-		edges_.insert(std::move(new_edge));
+		if (!linked) {
+			auto& in = dst_node.in;
+			auto const src = src_node.id;
+			if (dst_node.deferred_in.empty() && (in.empty() || in.back() < src)) {
+				in.push_back(src);
+			}
+			else if (dst_node.deferred_in.empty() && in.size() < defer_limit) {
+				in.insert(std::lower_bound(in.begin(), in.end(), src), src);
+			}
+			else {
+				dst_node.deferred_in.push_back(src);
+				defer(dst_node);
+			}
+		}
 		return true;
 	}
 
@@ -321,80 +664,94 @@ namespace gdwg {
 		if (is_node(new_data)) {
 			return false;
 		}
-		nodes_.erase(old_data);
-		nodes_.insert(new_data);
-
-		std::set<std::unique_ptr<Edge<N, E>>, EdgeComparator<N, E>> new_edges;
-		for (auto const& edge : edges_) {
-			auto [src, dst] = edge->get_nodes();
-			auto weight = edge->get_weight();
-
-			if (src == old_data)
-				src = new_data;
-			if (dst == old_data)
-				dst = new_data;
-
-			std::unique_ptr<Edge<N, E>> new_edge;
-			if (weight.has_value()) {
-				new_edge = std::make_unique<WeightedEdge<N, E>>(src, dst, weight.value());
-			}
-			else {
-				new_edge = std::make_unique<UnweightedEdge<N, E>>(src, dst);
-			}
+		settle();
 
-			// duplicate edges will be removed
-			new_edges.insert(std::move(new_edge));
+		// the node keeps its id, so each list of edges into it only moves its run to the new value's
+		// place, which is found while the id still maps to the old value
+		auto node = nodes_.extract(old_data);
+		auto const id = node.mapped().id;
+		for (auto const src : node.mapped().in) {
+			move_run(table_->node(src).out, old_data, new_data, id);
 		}
 
-		edges_ = std::move(new_edges);
+		node.key() = new_data;
+		auto const renamed = nodes_.insert(std::move(node)).position;
+		table_->entries[id] = &*renamed;
 		return true;
 	}
 
 	template<typename N, typename E>
 	auto Graph<N, E>::merge_replace_node(N const& old_data, N const& new_data) -> void {
-		if (!is_node(old_data) || !is_node(new_data)) {
+		auto const old_it = nodes_.find(old_data);
+		auto const new_it = nodes_.find(new_data);
+		if (old_it == nodes_.end() || new_it == nodes_.end()) {
 			throw std::runtime_error("Cannot call gdwg::Graph<N, E>::merge_replace_node on old or new data if they "
 			                         "don't exist in the graph");
 		}
-		std::set<std::unique_ptr<Edge<N, E>>, EdgeComparator<N, E>> new_edges;
-
-		for (auto const& edge : edges_) {
-			auto [src, dst] = edge->get_nodes();
-			auto weight = edge->get_weight();
+		// merging a node into itself leaves it and its edges in place
+		if (old_it == new_it) {
+			return;
+		}
+		settle();
 
-			if (src == old_data)
-				src = new_data;
-			if (dst == old_data)
-				dst = new_data;
+		auto& old_node = old_it->second;
+		auto& new_node = new_it->second;
+		auto const old_id = old_node.id;
+		auto const new_id = new_node.id;
 
-			std::unique_ptr<Edge<N, E>> new_edge;
-			if (weight.has_value()) {
-				new_edge = std::make_unique<WeightedEdge<N, E>>(src, dst, weight.value());
+		// edges into old now go into new: each list's run to old joins its run to new
+		for (auto const src : old_node.in) {
+			if (src != old_id) {
+				move_run(table_->node(src).out, old_data, new_data, new_id);
+				link(src, new_node);
 			}
-			else {
-				new_edge = std::make_unique<UnweightedEdge<N, E>>(src, dst);
-			}
-			new_edges.insert(std::move(new_edge));
 		}
-		edges_ = std::move(new_edges);
-		nodes_.erase(old_data);
+
+		// edges out of old now come out of new, old's edges to itself included
+		auto& moved = old_node.out;
+		move_run(moved, old_data, new_data, new_id);
+		for (auto const& edge : moved) {
+			unlink(old_id, table_->node(edge.dst));
+			link(new_id, table_->node(edge.dst));
+		}
+		auto merged = std::vector<OutEdge>{};
+		merged.reserve(new_node.out.size() + moved.size());
+		std::merge(new_node.out.begin(),
+		           new_node.out.end(),
+		           moved.begin(),
+		           moved.end(),
+		           std::back_inserter(merged),
+		           edge_less());
+		merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+		new_node.out = std::move(merged);
+
+		nodes_.erase(old_it);
+		release(old_id);
 	}
 
 	template<typename N, typename E>
 	auto Graph<N, E>::erase_node(N const& value) -> bool {
-		if (!is_node(value)) {
+		auto const it = nodes_.find(value);
+		if (it == nodes_.end()) {
 			return false;
 		}
-		nodes_.erase(value);
-		for (auto it = edges_.begin(); it != edges_.end();) {
-			auto [src, dst] = (*it)->get_nodes();
-			if (src == value || dst == value) {
-				it = edges_.erase(it);
+		settle();
+		auto const& node = it->second;
+		auto const id = node.id;
+		for (auto const src : node.in) {
+			if (src != id) {
+				auto& out = table_->node(src).out;
+				auto [first, last] = dst_range(out, value);
+				out.erase(first, last);
 			}
-			else {
-				++it;
+		}
+		for (auto const& edge : node.out) {
+			if (edge.dst != id) {
+				unlink(id, table_->node(edge.dst));
 			}
 		}
+		nodes_.erase(it);
+		release(id);
 		return true;
 	}
 
@@ -405,52 +762,42 @@ namespace gdwg {
 			                         "the graph");
 		}
 
-		for (auto it = edges_.begin(); it != edges_.end(); ++it) {
-			auto const& edge = *it;
-			auto [e_src, e_dst] = edge->get_nodes();
-
-			if (e_src == src && e_dst == dst) {
-				// no weight
-				if (!weight.has_value() && !edge->is_weighted()) {
-					edges_.erase(it);
-					return true;
-				}
-				// weight
-				if (weight.has_value() && edge->is_weighted() && edge->get_weight() == weight) {
-					edges_.erase(it);
-					return true;
-				}
-			}
+		auto it = find(src, dst, std::move(weight));
+		if (it == end()) {
+			return false;
 		}
-		return false;
+		erase_edge(it);
+		return true;
 	}
 
 	template<typename N, typename E>
 	auto Graph<N, E>::erase_edge(iterator i) -> iterator {
-		auto next = std::next(i);
+		erase_out(table_->node(i.node_->second.id), i.index_, i.index_ + 1);
 
-		edges_.erase(i);
-
-		return next;
+		// the next edge has moved into i's slot, or i is now past the end of its node's edges
+		i.skip_empty();
+		return i;
 	}
 
 	template<typename N, typename E>
 	auto gdwg::Graph<N, E>::erase_edge(iterator i, iterator s) -> iterator {
-		if (i == s) {
-			return s;
-		}
-		auto return_it = s;
-
+		// erase a node's share of [i, s) in one go; s shifts down by that much if it's in the same list
 		while (i != s) {
-			i = edges_.erase(i);
+			auto& src = table_->node(i.node_->second.id);
+			erase_out(src, i.index_, i.node_ == s.node_ ? s.index_ : src.out.size());
+			if (i.node_ == s.node_) {
+				s.index_ = i.index_;
+				s.skip_empty();
+			}
+			i.skip_empty();
 		}
-		return return_it;
+		return s;
 	}
 
 	template<typename N, typename E>
 	auto gdwg::Graph<N, E>::clear() noexcept -> void {
 		nodes_.clear();
-		edges_.clear();
+		table_.reset();
 	}
 
 } // namespace gdwg
@@ -2,7 +2,16 @@
 
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 TEST_CASE("insert_node and insert_edge basic test") {
 	auto g = gdwg::Graph<std::string, int>{};
@@ -73,6 +82,20 @@ TEST_CASE("merge_replace_node test") {
 	REQUIRE(g.insert_edge("C", "B", 5));
 }
 
+TEST_CASE("merging a node into itself leaves the graph unchanged") {
+	auto g = gdwg::Graph<std::string, int>{"a", "b"};
+	g.insert_edge("a", "a", 1);
+	g.insert_edge("a", "b");
+	g.insert_edge("b", "a", 2);
+	auto const before = g;
+
+	g.merge_replace_node("a", "a");
+	REQUIRE(g == before);
+	REQUIRE(g.is_node("a"));
+	REQUIRE(g.connections("a") == std::vector<std::string>{"a", "b"});
+	REQUIRE(g.connections("b") == std::vector<std::string>{"a"});
+}
+
 TEST_CASE("erase_node basic test") {
 	auto g = gdwg::Graph<std::string, int>{};
 	g.insert_node("A");
@@ -281,6 +304,295 @@ TEST_CASE("accessors test 4: connections()") {
 	}
 }
 
+TEST_CASE("queries only see edges of the requested source and destination") {
+	auto g = gdwg::Graph<int, int>{};
+	for (auto n = 1; n <= 4; ++n) {
+		g.insert_node(n);
+	}
+	g.insert_edge(1, 4, 7);
+	g.insert_edge(2, 1);
+	g.insert_edge(2, 3, 1);
+	g.insert_edge(2, 3);
+	g.insert_edge(2, 4, -2);
+	g.insert_edge(3, 2, 9);
+
+	REQUIRE(g.connections(2) == std::vector<int>{1, 3, 4});
+	REQUIRE(g.connections(4).empty());
+	REQUIRE(g.is_connected(2, 3));
+	REQUIRE_FALSE(g.is_connected(2, 2));
+	REQUIRE_FALSE(g.is_connected(4, 1));
+	REQUIRE(g.edges(2, 3).size() == 2);
+	REQUIRE(g.edges(3, 3).empty());
+
+	REQUIRE(g.find(2, 3, 1) != g.end());
+	REQUIRE(g.find(2, 3, 2) == g.end());
+	REQUIRE(g.find(2, 4) == g.end());
+	REQUIRE((*g.find(2, 3))->print_edge() == "2 -> 3 | U");
+
+	REQUIRE(g.erase_edge(2, 3));
+	REQUIRE_FALSE(g.erase_edge(2, 3));
+	REQUIRE_FALSE(g.erase_edge(2, 4, 2));
+	REQUIRE(g.edges(2, 3).size() == 1);
+	REQUIRE(g.connections(2) == std::vector<int>{1, 3, 4});
+}
+
+TEST_CASE("copies and moves keep edges bound to their own graph's nodes") {
+	auto g = gdwg::Graph<std::string, int>{"a", "b", "c"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "c");
+	g.insert_edge("c", "a", 3);
+
+	auto copy = std::make_unique<gdwg::Graph<std::string, int>>(g);
+	g.replace_node("a", "z");
+	g.erase_node("b");
+	REQUIRE(copy->is_connected("a", "b"));
+	REQUIRE((*copy->begin())->print_edge() == "a -> b | W | 1");
+
+	auto moved = std::move(*copy);
+	copy.reset();
+	REQUIRE(moved.connections("b") == std::vector<std::string>{"c"});
+	REQUIRE((*moved.find("c", "a", 3))->print_edge() == "c -> a | W | 3");
+
+	// a node inserted after an erase reuses the erased node's slot without picking up its edges
+	REQUIRE(g.insert_node("b"));
+	REQUIRE(g.connections("b").empty());
+	REQUIRE(g.connections("c") == std::vector<std::string>{"z"});
+
+	g = moved;
+	REQUIRE(g == moved);
+	REQUIRE((*std::next(g.begin()))->print_edge() == "b -> c | U");
+}
+
+TEST_CASE("renaming and merging nodes re-sorts their edges") {
+	auto g = gdwg::Graph<std::string, int>{"a", "m", "z"};
+	g.insert_edge("a", "z", 1);
+	g.insert_edge("a", "m", 1);
+	g.insert_edge("z", "a");
+
+	REQUIRE(g.replace_node("z", "b"));
+	REQUIRE(g.connections("a") == std::vector<std::string>{"b", "m"});
+	REQUIRE((*g.begin())->print_edge() == "a -> b | W | 1");
+	REQUIRE((*std::prev(g.end()))->print_edge() == "b -> a | U");
+
+	g.merge_replace_node("m", "b");
+	REQUIRE(g.nodes() == std::vector<std::string>{"a", "b"});
+	REQUIRE(g.edges("a", "b").size() == 1);
+	REQUIRE(std::distance(g.begin(), g.end()) == 2);
+}
+
+TEST_CASE("renamed and merged runs move past other edges in either direction") {
+	auto g = gdwg::Graph<int, int>{0, 2, 4, 6, 8};
+	for (auto const dst : {2, 4, 6, 8}) {
+		g.insert_edge(0, dst, 1);
+		g.insert_edge(0, dst, dst);
+	}
+	g.insert_edge(0, 6);
+	auto const weights = [&g](int dst) {
+		auto result = std::vector<std::optional<int>>{};
+		for (auto const& edge : g.edges(0, dst)) {
+			result.push_back(edge->get_weight());
+		}
+		return result;
+	};
+
+	// 2 -> 9 moves right past every other run, 8 -> 1 moves left past them
+	REQUIRE(g.replace_node(2, 9));
+	REQUIRE(g.replace_node(8, 1));
+	REQUIRE(g.connections(0) == std::vector<int>{1, 4, 6, 9});
+	REQUIRE(weights(9) == std::vector<std::optional<int>>{1, 2});
+
+	// merging 9 into 4 moves its run left and interleaves the weights, dropping the duplicate 1
+	g.merge_replace_node(9, 4);
+	REQUIRE(weights(4) == std::vector<std::optional<int>>{1, 2, 4});
+	// merging 1 into 6 moves its run right, ahead of the unweighted edge
+	g.merge_replace_node(1, 6);
+	REQUIRE(weights(6) == std::vector<std::optional<int>>{std::nullopt, 1, 6, 8});
+	REQUIRE(g.connections(0) == std::vector<int>{4, 6});
+	REQUIRE(std::distance(g.begin(), g.end()) == 7);
+}
+
+TEST_CASE("iterators walk every node's edges in order") {
+	auto g = gdwg::Graph<int, int>{1, 2, 3, 4, 5};
+	g.insert_edge(4, 1, 2);
+	g.insert_edge(2, 5);
+	g.insert_edge(2, 3, 1);
+	g.insert_edge(4, 1);
+
+	auto printed = std::vector<std::string>{};
+	for (auto it = g.begin(); it != g.end(); ++it) {
+		printed.push_back((*it)->print_edge());
+	}
+	REQUIRE(printed == std::vector<std::string>{"2 -> 3 | W | 1", "2 -> 5 | U", "4 -> 1 | U", "4 -> 1 | W | 2"});
+
+	// nodes 1, 3 and 5 have no outgoing edges and are skipped in both directions
+	auto it = std::prev(g.end());
+	REQUIRE((*it)->get_nodes() == std::pair{4, 1});
+	REQUIRE((*std::prev(it, 2))->print_edge() == "2 -> 5 | U");
+	REQUIRE(std::prev(it, 3) == g.begin());
+
+	SECTION("erasing the last edge of a node moves on to the next node") {
+		auto next = g.erase_edge(std::next(g.begin()));
+		REQUIRE((*next)->print_edge() == "4 -> 1 | U");
+		REQUIRE(std::distance(g.begin(), g.end()) == 3);
+	}
+
+	SECTION("erasing a range within one node") {
+		auto first = g.find(4, 1);
+		auto next = g.erase_edge(first, std::next(first));
+		REQUIRE((*next)->print_edge() == "4 -> 1 | W | 2");
+		REQUIRE(g.edges(4, 1).size() == 1);
+	}
+
+	SECTION("erasing a range that ends at the end of a node") {
+		auto next = g.erase_edge(g.begin(), g.find(4, 1));
+		REQUIRE(next == g.begin());
+		REQUIRE(g.connections(2).empty());
+		REQUIRE(std::distance(g.begin(), g.end()) == 2);
+	}
+}
+
+TEST_CASE("insert_edge rejects duplicates in any insertion order") {
+	constexpr auto n = 300;
+	auto g = gdwg::Graph<int, int>{};
+	for (auto v = 0; v < n; ++v) {
+		g.insert_node(v);
+	}
+	// every edge is inserted twice: once going forwards and once backwards through the destinations
+	auto inserted = 0;
+	auto rejected = 0;
+	for (auto src = 0; src < n; ++src) {
+		auto const weight = [src](int dst) { return src % 3 == 0 ? std::nullopt : std::optional<int>{dst}; };
+		for (auto dst = 0; dst < n; ++dst) {
+			inserted += g.insert_edge(src, dst, weight(dst)) ? 1 : 0;
+		}
+		for (auto dst = n - 1; dst >= 0; --dst) {
+			rejected += g.insert_edge(src, dst, weight(dst)) ? 0 : 1;
+		}
+		inserted += g.insert_edge(src, n / 2, -1) ? 1 : 0;
+	}
+
+	REQUIRE(inserted == n * (n + 1));
+	REQUIRE(rejected == n * n);
+	REQUIRE(std::distance(g.begin(), g.end()) == n * (n + 1));
+	REQUIRE(g.edges(7, n / 2).size() == 2);
+	REQUIRE((*g.find(7, n / 2, -1))->print_edge() == "7 -> 150 | W | -1");
+	REQUIRE(g.find(6, n / 2, n / 2) == g.end());
+}
+
+TEST_CASE("a high-degree node loads in random order") {
+	constexpr auto n = 100'000;
+	auto g = gdwg::Graph<int, int>{};
+	for (auto v = 0; v <= n; ++v) {
+		g.insert_node(v);
+	}
+	auto order = std::vector<int>(n);
+	std::iota(order.begin(), order.end(), 1);
+	std::shuffle(order.begin(), order.end(), std::mt19937{6771});
+
+	// node 0 gets an edge to and from every other node, and 1 gets two weights for each of them
+	auto inserted = 0;
+	auto rejected = 0;
+	for (auto const v : order) {
+		inserted += g.insert_edge(0, v, v % 7) ? 1 : 0;
+		inserted += g.insert_edge(v, 0) ? 1 : 0;
+		inserted += g.insert_edge(1, v, 1) && g.insert_edge(1, v) ? 2 : 0;
+		rejected += g.insert_edge(0, v, v % 7) ? 0 : 1;
+	}
+	REQUIRE(inserted == 4 * n);
+	REQUIRE(rejected == n);
+
+	// compared with ranges::equal so that a failure doesn't print every node
+	auto expected = order;
+	std::sort(expected.begin(), expected.end());
+	REQUIRE(std::ranges::equal(g.connections(0), expected));
+	expected.insert(expected.begin(), 0);
+	REQUIRE(std::ranges::equal(g.connections(1), expected));
+	REQUIRE(g.edges(1, 7).size() == 2);
+	REQUIRE((*g.find(0, 7, 0))->print_edge() == "0 -> 7 | W | 0");
+	REQUIRE(std::distance(g.begin(), g.end()) == 4 * n);
+
+	// a read merges the waiting edges; later insertions wait again, and updates see all of them
+	REQUIRE_FALSE(g.insert_edge(0, 3, 3));
+	REQUIRE(g.insert_edge(0, 3, -3));
+	REQUIRE(g.replace_node(1, -1));
+	REQUIRE(g.edges(-1, 3).size() == 2);
+	REQUIRE(g.erase_node(0));
+	REQUIRE(g.connections(5).empty());
+	REQUIRE(std::distance(g.begin(), g.end()) == 2 * n);
+}
+
+TEST_CASE("concurrent const reads of deferred edges") {
+	constexpr auto n = 2'000;
+	auto g = gdwg::Graph<int, int>{};
+	for (auto v = 0; v <= n; ++v) {
+		g.insert_node(v);
+	}
+	// backwards, so that all but the first edges wait to be merged
+	for (auto v = n; v >= 1; --v) {
+		g.insert_edge(0, v);
+		g.insert_edge(v, 0);
+	}
+
+	// each reader, or the copy, is the first to read and may be the one that merges
+	auto const& shared = g;
+	auto results = std::vector<std::vector<int>>(4);
+	{
+		auto readers = std::vector<std::jthread>{};
+		readers.emplace_back([&shared, &results] { results[0] = gdwg::Graph<int, int>{shared}.connections(0); });
+		for (auto i = std::size_t{1}; i < results.size(); ++i) {
+			readers.emplace_back([&shared, &result = results[i]] { result = shared.connections(0); });
+		}
+	}
+	for (auto const& result : results) {
+		REQUIRE(result.size() == n);
+		REQUIRE(std::ranges::is_sorted(result));
+	}
+	REQUIRE(std::distance(g.begin(), g.end()) == 2 * n);
+}
+
+TEST_CASE("node updates only touch incident edges and keep the graph consistent") {
+	auto g = gdwg::Graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "c", 1);
+	g.insert_edge("b", "b");
+	g.insert_edge("c", "b", 1);
+	g.insert_edge("c", "d");
+	g.insert_edge("d", "a", 4);
+
+	// c -> b duplicates nothing, b -> b becomes c -> c, a -> b and a -> c collapse
+	g.merge_replace_node("b", "c");
+	auto out = std::ostringstream{};
+	out << g;
+	REQUIRE(out.str() == R"(a (
+  a -> c | W | 1
+)
+c (
+  c -> c | U
+  c -> c | W | 1
+  c -> d | U
+)
+d (
+  d -> a | W | 4
+)
+)");
+
+	// renaming moves d's edges into a and out of d into place; erasing a drops them everywhere
+	REQUIRE(g.replace_node("d", "0"));
+	REQUIRE((*g.begin())->print_edge() == "0 -> a | W | 4");
+	REQUIRE(g.connections("c") == std::vector<std::string>{"0", "c"});
+	REQUIRE(g.erase_node("a"));
+	REQUIRE(g.connections("0").empty());
+
+	// erasing edges one at a time leaves no stale in-edges behind: c is no longer linked from itself
+	REQUIRE(g.erase_edge("c", "c"));
+	REQUIRE(g.erase_edge("c", "c", 1));
+	g.merge_replace_node("0", "c");
+	REQUIRE(g.connections("c") == std::vector<std::string>{"c"});
+	REQUIRE(g.erase_node("c"));
+	REQUIRE(g.begin() == g.end());
+	REQUIRE(g.nodes().empty());
+}
+
 TEST_CASE("operator== ") {
 	auto g1 = gdwg::Graph<std::string, int>();
 	auto g2 = gdwg::Graph<std::string, int>();